@@ -0,0 +1,20 @@
+// Request GLSL 3.3
+#version 330
+
+// This corresponds to the output color to the color buffer
+out vec4 outColor;
+
+// This is used for the texture sampling
+uniform sampler2D uTexture;
+
+in vec2 fragTexCoord;
+in vec3 fragColor;
+in float fragTextureFactor;
+
+void main()
+{
+    // Same blend as Base.frag and Sprite.frag
+    vec4 texColor = texture(uTexture, fragTexCoord);
+    vec4 solidColor = vec4(fragColor, 1.0);
+    outColor = mix(solidColor, texColor, fragTextureFactor);
+}
@@ -0,0 +1,34 @@
+// Request GLSL 3.3
+#version 330
+
+// Unit quad shared by every particle
+layout (location = 0) in vec2 inPosition;
+layout (location = 1) in vec2 inTexCoord;
+
+// Per instance data, rotation rides in the z of the position
+layout (location = 2) in vec3 inInstanceTransform;
+layout (location = 3) in vec2 inInstanceSize;
+layout (location = 4) in vec4 inInstanceTexRect;
+layout (location = 5) in vec4 inInstanceColor;
+
+uniform mat4 uOrthoProj;
+uniform vec2 uCameraPos;
+
+out vec2 fragTexCoord;
+out vec3 fragColor;
+out float fragTextureFactor;
+
+void main()
+{
+    // Scale, rotate, translate, same order as the base shader's world transform
+    vec2 local = inPosition * inInstanceSize;
+    float c = cos(inInstanceTransform.z);
+    float s = sin(inInstanceTransform.z);
+    vec2 world = vec2(local.x * c - local.y * s, local.x * s + local.y * c) + inInstanceTransform.xy;
+
+    fragTexCoord = inTexCoord * inInstanceTexRect.zw + inInstanceTexRect.xy;
+    fragColor = inInstanceColor.rgb;
+    fragTextureFactor = inInstanceColor.a;
+
+    gl_Position = uOrthoProj * vec4(world - uCameraPos, 0.0, 1.0);
+}
@@ -0,0 +1,24 @@
+// Request GLSL 3.3
+#version 330
+
+// Sprites are batched, so everything that used to be a uniform comes per vertex.
+// Positions are already in world space with the camera applied
+layout (location = 0) in vec2 inPosition;
+layout (location = 1) in vec2 inTexCoord;
+layout (location = 2) in vec3 inColor;
+layout (location = 3) in float inTextureFactor;
+
+uniform mat4 uOrthoProj;
+
+out vec2 fragTexCoord;
+out vec3 fragColor;
+out float fragTextureFactor;
+
+void main()
+{
+    fragTexCoord = inTexCoord;
+    fragColor = inColor;
+    fragTextureFactor = inTextureFactor;
+
+    gl_Position = uOrthoProj * vec4(inPosition, 0.0, 1.0);
+}
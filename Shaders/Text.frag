@@ -0,0 +1,18 @@
+// Request GLSL 3.3
+#version 330
+
+// This corresponds to the output color to the color buffer
+out vec4 outColor;
+
+// Glyph atlas, glyphs are white and only their coverage is used
+uniform sampler2D uTexture;
+
+in vec2 fragTexCoord;
+in vec3 fragColor;
+in float fragTextureFactor;
+
+void main()
+{
+    float coverage = texture(uTexture, fragTexCoord).a;
+    outColor = vec4(fragColor, coverage);
+}
@@ -1,5 +1,6 @@
 #include "ChaseBehavior.h"
 #include "../../Actors/Characters/ShadowCat.h"
+#include "../../Components/Physics/Physics.h"
 
 namespace
 {
@@ -25,8 +26,11 @@ void ChaseBehavior::Update(float deltaTime)
     
     mOwner->StopMovement();
     
+    // Once the player is out of range or behind a wall, head for where they were last seen
     float distanceToPlayer = (player->GetPosition() - mOwner->GetPosition()).Length();
-    auto pos = distanceToPlayer <= mChaseRange ? player->GetPosition() : mLastKnownPlayerPos;
+    bool canSeePlayer = distanceToPlayer <= mChaseRange &&
+                        Physics::HasLineOfSight(mOwner->GetGame(), mOwner->GetPosition(), player->GetPosition());
+    auto pos = canSeePlayer ? player->GetPosition() : mLastKnownPlayerPos;
     mLastKnownPlayerPos = pos;
     
     mOwner->MoveToward(pos);
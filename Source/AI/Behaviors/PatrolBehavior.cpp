@@ -3,6 +3,7 @@
 #include "../../Random.h"
 #include "../../Game.h"
 #include "../../Actors/Characters/ShadowCat.h"
+#include "../../Components/Physics/Physics.h"
 
 namespace
 {
@@ -83,12 +84,17 @@ bool PatrolBehavior::PatrolToChase()
     Vector2 toPlayer = player->GetPosition() - mOwner->GetPosition();
     float distanceToPlayer = toPlayer.Length();
 
-    if (distanceToPlayer <= mDetectionRange) return true;
-    if (distanceToPlayer > mVisionRange) return false;
+    if (distanceToPlayer > mDetectionRange)
+    {
+        if (distanceToPlayer > mVisionRange) return false;
 
-    toPlayer.Normalize();
-    Vector2 forwardDir = mOwner->GetForward();
+        toPlayer.Normalize();
+        Vector2 forwardDir = mOwner->GetForward();
 
-    float angleToPlayer = Math::Acos(Vector2::Dot(forwardDir, toPlayer));;
-    return angleToPlayer <= mDetectionAngle;
+        float angleToPlayer = Math::Acos(Vector2::Dot(forwardDir, toPlayer));
+        if (angleToPlayer > mDetectionAngle) return false;
+    }
+
+    // Walls block perception, checked last since it's the only test touching the level
+    return Physics::HasLineOfSight(mOwner->GetGame(), mOwner->GetPosition(), player->GetPosition());
 }
\ No newline at end of file
@@ -68,6 +68,10 @@ public:
 
     // Any actor-specific collision code (overridable)
     virtual void Kill();
+    // Raised by a ColliderComponent of this actor that reports contacts (overridable)
+    virtual void OnCollisionEnter(class ColliderComponent *other) {}
+    virtual void OnCollisionStay(class ColliderComponent *other) {}
+    virtual void OnCollisionExit(class ColliderComponent *other) {}
 
 protected:
     class Game *mGame;
@@ -88,8 +88,12 @@ void Character::ManageAnimations()
     if (mIsAnimationLocked) return;
     if (!mAnimatorComponent) return;
 
-    if (mIsMoving) mAnimatorComponent->LoopAnimation("Run");
-    else mAnimatorComponent->LoopAnimation("Idle");
+    // Runs every frame for every character, so the names are interned once
+    static const AssetName RUN_ANIMATION("Run");
+    static const AssetName IDLE_ANIMATION("Idle");
+
+    if (mIsMoving) mAnimatorComponent->LoopAnimation(RUN_ANIMATION);
+    else mAnimatorComponent->LoopAnimation(IDLE_ANIMATION);
 }
 
 void Character::MoveToward(const Vector2& target)
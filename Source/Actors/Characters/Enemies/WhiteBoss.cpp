@@ -54,12 +54,11 @@ void WhiteBoss::OnUpdate(float deltaTime)
 		{
 			mFootstepTimer = 0.4f; // Reset timer (slower than player)
 
-			// Use grass sounds for Boss 1
-			std::string sound1 = "e10_boss_step_on_grass1.wav";
-			std::string sound2 = "e11_boss_step_on_grass2.wav";
+			// Use grass sounds for Boss 1, interned once
+			static const AssetName STEPS[2] = {AssetName("e10_boss_step_on_grass1.wav"), AssetName("e11_boss_step_on_grass2.wav")};
 
 			// Play random one of the two sounds
-			GetGame()->GetAudio()->PlaySound(rand() % 2 ? sound1 : sound2, false, 1.0f);
+			GetGame()->GetAudio()->PlaySound(STEPS[rand() % 2], false, 1.0f);
 		}
 	}
 	else
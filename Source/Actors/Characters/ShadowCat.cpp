@@ -144,26 +144,28 @@ void ShadowCat::OnUpdate(float deltaTime)
         {
             mFootstepTimer = 0.3f;  // Reset timer
             
+            // Two footstep sounds per ground type, interned once
+            static const AssetName GRASS_STEPS[2] = {AssetName("e01_step_on_grass_small1.wav"), AssetName("e02_step_on_grass_small2.wav")};
+            static const AssetName BRICK_STEPS[2] = {AssetName("e06_step_on_bricks1.wav"), AssetName("e07_step_on_bricks2.wav")};
+            static const AssetName STONE_STEPS[2] = {AssetName("e08_step_on_stone1.wav"), AssetName("e09_step_on_stone2.wav")};
+
             // Determine which sounds to use based on ground type
-            std::string sound1, sound2;
+            const AssetName *steps = GRASS_STEPS;
             switch (mGame->GetGroundType())
             {
             case GroundType::Grass:
-                sound1 = "e01_step_on_grass_small1.wav";
-                sound2 = "e02_step_on_grass_small2.wav";
+                steps = GRASS_STEPS;
                 break;
             case GroundType::Brick:
-                sound1 = "e06_step_on_bricks1.wav";
-                sound2 = "e07_step_on_bricks2.wav";
+                steps = BRICK_STEPS;
                 break;
             case GroundType::Stone:
-                sound1 = "e08_step_on_stone1.wav";
-                sound2 = "e09_step_on_stone2.wav";
+                steps = STONE_STEPS;
                 break;
             }
             
             // Play random one of the two sounds
-            mGame->GetAudio()->PlaySound(rand() % 2 ? sound1 : sound2, false, 0.6f);
+            mGame->GetAudio()->PlaySound(steps[rand() % 2], false, 0.6f);
         }
     }
     else
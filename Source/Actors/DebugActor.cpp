@@ -1,10 +1,36 @@
-
 #include "DebugActor.h"
 #include "../Game.h"
-#include "../Components/ParticleSystemComponent.h"
+#include "../Renderer/Renderer.h"
+#include <algorithm>
 
 DebugActor::DebugActor(Game* game)
     : Actor(game)
 {
-    mParticleSystem = new ParticleSystemComponent(this, 3, 3, 100, 10, false);
-}
\ No newline at end of file
+}
+
+void DebugActor::OnUpdate(float deltaTime)
+{
+    for (auto& timed : mPolygons)
+        timed.timeLeft -= deltaTime;
+
+    mPolygons.erase(std::remove_if(mPolygons.begin(), mPolygons.end(),
+                                   [](const TimedPolygon& timed) { return timed.timeLeft <= 0.0f; }),
+                    mPolygons.end());
+}
+
+void DebugActor::AddPolygon(const FixedPolygon& polygon, float lifetime)
+{
+    if (polygon.count < 2) return;
+    mPolygons.push_back(TimedPolygon{polygon, lifetime});
+}
+
+void DebugActor::DrawPolygons(Renderer* renderer)
+{
+    Vector2 cameraPos = GetGame()->GetCameraPos();
+    for (const auto& timed : mPolygons)
+    {
+        const FixedPolygon& polygon = timed.polygon;
+        for (int i = 0; i < polygon.count; ++i)
+            renderer->DrawLine(polygon.GetVertex(i), polygon.GetVertex((i + 1) % polygon.count), Color::White, cameraPos);
+    }
+}
@@ -1,14 +1,25 @@
 #pragma once
 #include "Actor.h"
-
-class ParticleSystemComponent;
+#include "../Components/Physics/FixedPolygon.h"
+#include <vector>
 
 class DebugActor : public Actor {
 public:
     DebugActor(Game* game);
     ~DebugActor() override = default;
 
-    ParticleSystemComponent *GetParticleSystemComponent() { return mParticleSystem; }
+    void OnUpdate(float deltaTime) override;
+
+    // Keeps the polygon outlined for the given number of seconds
+    void AddPolygon(const FixedPolygon& polygon, float lifetime);
+    void DrawPolygons(class Renderer* renderer);
+
 private:
-    ParticleSystemComponent *mParticleSystem;
+    struct TimedPolygon
+    {
+        FixedPolygon polygon;
+        float timeLeft;
+    };
+
+    std::vector<TimedPolygon> mPolygons;
 };
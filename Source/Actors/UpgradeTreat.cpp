@@ -29,23 +29,28 @@ void UpgradeTreat::Awake(const Vector2& position)
 
 	mAnimatorComponent->SetEnabled(true);
 	mAnimatorComponent->SetVisible(true);
+
+	// The player doesn't collide with collectibles, so the pickup is a trigger
+	mColliderComponent->SetEnabled(true);
+	mColliderComponent->SetReportsContacts(true, true);
 }
 
 void UpgradeTreat::Kill()
 {
 	mCollected = true;
+	mColliderComponent->SetReportsContacts(false);
+	mColliderComponent->SetEnabled(false);
 
 	mAnimatorComponent->SetVisible(false);
 	mAnimatorComponent->SetEnabled(false);
 }
 
-void UpgradeTreat::OnUpdate(float deltaTime)
+void UpgradeTreat::OnCollisionEnter(ColliderComponent* other)
 {
 	if (mCollected) return;
 
 	auto player = mGame->GetPlayer();
-	auto playerCollider = player->GetComponent<ColliderComponent>()->GetCollider();
-	if (!mColliderComponent->GetCollider()->CheckCollision(playerCollider)) return;
+	if (other->GetOwner() != player) return;
 
 	player->AddUpgradePoint();
 	Kill();
@@ -13,7 +13,7 @@ public:
 	void Awake(const Vector2& position);
 	void Kill();
 	
-	void OnUpdate(float deltaTime) override;
+	void OnCollisionEnter(ColliderComponent* other) override;
 
 	bool IsCollected() const { return mCollected; }
 
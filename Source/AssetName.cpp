@@ -0,0 +1,29 @@
+#include "AssetName.h"
+
+uint32_t AssetName::Intern(const std::string& name)
+{
+    if (name.empty()) return 0;
+
+    auto& ids = GetIDs();
+    auto iter = ids.find(name);
+    if (iter != ids.end()) return iter->second;
+
+    auto& names = GetNames();
+    auto id = static_cast<uint32_t>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+// Function statics so names interned during static initialization of other files are safe
+std::deque<std::string>& AssetName::GetNames()
+{
+    static std::deque<std::string> names{std::string()};
+    return names;
+}
+
+std::unordered_map<std::string, uint32_t>& AssetName::GetIDs()
+{
+    static std::unordered_map<std::string, uint32_t> ids;
+    return ids;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <deque>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// Asset name interned once into a small integer. Comparing or hashing one is an integer
+// operation, so hot code keeps AssetNames around (as members or function statics) and only
+// the constructor ever touches the string. Interning is not thread safe, do it on the main thread
+class AssetName
+{
+public:
+    AssetName() : mID(0) {}
+    explicit AssetName(const std::string& name) : mID(Intern(name)) {}
+    explicit AssetName(const char* name) : mID(Intern(name)) {}
+
+    bool IsValid() const { return mID != 0; }
+    uint32_t GetID() const { return mID; }
+
+    // The original string, for logging and building file paths
+    const std::string& GetString() const { return GetNames()[mID]; }
+    const char* c_str() const { return GetString().c_str(); }
+
+    bool operator==(const AssetName& rhs) const { return mID == rhs.mID; }
+    bool operator!=(const AssetName& rhs) const { return mID != rhs.mID; }
+    bool operator<(const AssetName& rhs) const { return mID < rhs.mID; }
+
+    // Number of distinct names interned so far
+    static int GetInternedCount() { return static_cast<int>(GetNames().size()) - 1; }
+
+private:
+    static uint32_t Intern(const std::string& name);
+
+    // Index 0 is the empty name every default constructed AssetName points at. A deque so
+    // the strings GetString hands out never move
+    static std::deque<std::string>& GetNames();
+    static std::unordered_map<std::string, uint32_t>& GetIDs();
+
+    uint32_t mID;
+};
+
+namespace std
+{
+    template <>
+    struct hash<AssetName>
+    {
+        size_t operator()(const AssetName& name) const noexcept { return name.GetID(); }
+    };
+}
@@ -47,7 +47,7 @@ void AudioSystem::Update(float deltaTime)
 // NOTE: The soundName is without the "Assets/Sounds/" part of the file
 //       For example, pass in "ChompLoop.wav" rather than
 //       "Assets/Sounds/ChompLoop.wav".
-SoundHandle AudioSystem::PlaySound(const std::string& soundName, bool looping, float volume)
+SoundHandle AudioSystem::PlaySound(AssetName soundName, bool looping, float volume)
 {
     // Get the sound with the given name
     Mix_Chunk *sound = GetSound(soundName);
@@ -221,7 +221,7 @@ void AudioSystem::CacheAllSounds()
 //       "Assets/Sounds/ChompLoop.wav".
 void AudioSystem::CacheSound(const std::string& soundName)
 {
-    GetSound(soundName);
+    GetSound(AssetName(soundName));
 }
 
 // If the sound is already loaded, returns Mix_Chunk from the map.
@@ -230,19 +230,20 @@ void AudioSystem::CacheSound(const std::string& soundName)
 // NOTE: The soundName is without the "Assets/Sounds/" part of the file
 //       For example, pass in "ChompLoop.wav" rather than
 //       "Assets/Sounds/ChompLoop.wav".
-Mix_Chunk* AudioSystem::GetSound(const std::string& soundName)
+Mix_Chunk* AudioSystem::GetSound(AssetName soundName)
 {
-    std::string fileName = "../Assets/Sounds/";
-    fileName += soundName;
-
     Mix_Chunk* chunk = nullptr;
-    auto iter = mSounds.find(fileName);
+    auto iter = mSounds.find(soundName);
     if (iter != mSounds.end())
     {
         chunk = iter->second;
     }
     else
     {
+        // The path is only built the first time a sound is requested
+        std::string fileName = "../Assets/Sounds/";
+        fileName += soundName.GetString();
+
         chunk = Mix_LoadWAV(fileName.c_str());
         if (!chunk)
         {
@@ -250,7 +251,7 @@ Mix_Chunk* AudioSystem::GetSound(const std::string& soundName)
             return nullptr;
         }
 
-        mSounds.emplace(fileName, chunk);
+        mSounds.emplace(soundName, chunk);
     }
     return chunk;
 }
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "SDL_stdinc.h"
+#include "AssetName.h"
 
 
 // SoundHandles are used to operate on active sounds
@@ -80,7 +81,13 @@ public:
     // NOTE: The soundName is without the "Assets/Sounds/" part of the file
     //       For example, pass in "ChompLoop.wav" rather than
     //       "Assets/Sounds/ChompLoop.wav".
-    SoundHandle PlaySound(const std::string& soundName, bool looping = false, float volume = 1.0f);
+    // Code that plays sounds often (footsteps, hits) should keep the AssetName around,
+    // the string overload interns the name on every call
+    SoundHandle PlaySound(AssetName soundName, bool looping = false, float volume = 1.0f);
+    SoundHandle PlaySound(const std::string& soundName, bool looping = false, float volume = 1.0f)
+    {
+        return PlaySound(AssetName(soundName), looping, volume);
+    }
 
     // Stops the sound if it is currently playing
     void StopSound(SoundHandle sound);
@@ -113,12 +120,12 @@ private:
     // NOTE: The soundName is without the "Assets/Sounds/" part of the file
     //       For example, pass in "ChompLoop.wav" rather than
     //       "Assets/Sounds/ChompLoop.wav".
-    struct Mix_Chunk* GetSound(const std::string& soundName);
+    struct Mix_Chunk* GetSound(AssetName soundName);
 
     // Internal struct used to track the properties of active sound handles
     struct HandleInfo
     {
-        std::string mSoundName;
+        AssetName mSoundName;
         int mChannel = -1;
         bool mIsLooping = false;
         bool mIsPaused = false;
@@ -132,8 +139,8 @@ private:
     // Maps all the active SoundHandles to their HandleInfo
     std::map<SoundHandle, HandleInfo> mHandleMap;
 
-    // Map to store the Mix_Chunk data for all the files
-    std::unordered_map<std::string, Mix_Chunk*> mSounds;
+    // Map to store the Mix_Chunk data for all the files, keyed by sound name
+    std::unordered_map<AssetName, Mix_Chunk*> mSounds;
 
     // Used to track the last audio handle value used
     // Will increment prior to playing a new sound
@@ -4,12 +4,14 @@
 #include "Physics/ColliderComponent.h"
 #include "Physics/CollisionFilter.h"
 #include "Physics/RigidBodyComponent.h"
+#include "../Game.h"
+#include "../Renderer/ParticleBatch.h"
+#include "../Renderer/TextureAtlas.h"
 
 
-AnimatedParticle::AnimatedParticle(class Game *game, bool hasCollider, std::string particleAnimName)
-	: Actor(game), mAnimatorComponent(nullptr), mRigidBodyComponent(nullptr), mColliderComponent(nullptr), mIsDead(true), mLifeTime(1.0f)
+AnimatedParticle::AnimatedParticle(class Game *game, bool hasCollider)
+	: Actor(game), mRigidBodyComponent(nullptr), mColliderComponent(nullptr), mIsDead(true), mLifeTime(1.0f), mTotalLifeTime(1.0f)
 {
-	mAnimatorComponent = new AnimatorComponent(this, particleAnimName, GameConstants::TILE_SIZE, GameConstants::TILE_SIZE);
 	mRigidBodyComponent = new RigidBodyComponent(this, 1.0f, 0.0f, true);
 
 	if (hasCollider)
@@ -23,14 +25,12 @@ AnimatedParticle::AnimatedParticle(class Game *game, bool hasCollider, std::stri
 	} 
 
 	SetState(ActorState::Paused);
-	mAnimatorComponent->SetVisible(false);
 }
 
 void AnimatedParticle::Kill()
 {
 	mIsDead = true;
 	SetState(ActorState::Paused);
-	mAnimatorComponent->SetVisible(false);
 	if (mColliderComponent) mColliderComponent->SetEnabled(false);
 
 	// Reset velocity
@@ -40,12 +40,10 @@ void AnimatedParticle::Kill()
 void AnimatedParticle::Awake(const Vector2 &position, float rotation, float lifetime, bool flipV)
 {
 	mLifeTime = lifetime;
+	mTotalLifeTime = lifetime;
 
 	mIsDead = false;
 	SetState(ActorState::Active);
-	mAnimatorComponent->SetVisible(true);
-	mAnimatorComponent->ResetAnimation();
-	mAnimatorComponent->SetAnimSpeed(mAnimatorComponent->GetCurrentAnimationDuration() / lifetime); // Adjust animation speed to match lifetime
 	if (mColliderComponent) mColliderComponent->SetEnabled(true);
 
 	if (flipV)
@@ -67,17 +65,47 @@ void AnimatedParticle::OnUpdate(float deltaTime)
 	}
 }
 
-AnimatedParticleSystemComponent::AnimatedParticleSystemComponent(class Actor *owner, std::string particlePath, bool hasCollider, int poolSize, int updateOrder)
-	: Component(owner, updateOrder)
+AnimatedParticleSystemComponent::AnimatedParticleSystemComponent(class Actor *owner, std::string particlePath, bool hasCollider, int poolSize, int drawOrder)
+	: DrawComponent(owner, drawOrder), mTextureRect(Vector4::UnitRect), mTotalDuration(0.0f), mBatch(new ParticleBatch(poolSize))
 {
+	// Frames of the base animation, the same ones an AnimatorComponent would loop
+	AnimationSheet sheet;
+	if (AnimatorComponent::LoadAnimationSheet(particlePath, sheet))
+	{
+		mTexture = TextureHandle(owner->GetGame()->GetRenderer()->GetTextureRegion(sheet.texturePath, mTextureRect));
+		for (auto &sprite : sheet.sprites)
+			sprite.uv = TextureAtlas::RemapRect(sprite.uv, mTextureRect);
+
+		auto iter = sheet.animations.find(sheet.baseAnimation);
+		if (iter == sheet.animations.end()) iter = sheet.animations.begin();
+
+		if (iter != sheet.animations.end())
+		{
+			for (int index : iter->second)
+				if (index >= 0 && index < static_cast<int>(sheet.sprites.size())) mFrames.push_back(sheet.sprites[index]);
+		}
+		else
+			mFrames = sheet.sprites;
+
+		for (const auto &frame : mFrames)
+			mTotalDuration += frame.duration;
+	}
+	else
+		mTexture = TextureHandle(owner->GetGame()->GetRenderer()->GetTextureRegion("../Assets/Sprites/NoTexture/NoTexture.png", mTextureRect));
+
 	// Create a pool of particles
 	for (int i = 0; i < poolSize; i++)
 	{
-		auto *p = new AnimatedParticle(owner->GetGame(), hasCollider, particlePath);
+		auto *p = new AnimatedParticle(owner->GetGame(), hasCollider);
 		mParticles.push_back(p);
 	}
 }
 
+AnimatedParticleSystemComponent::~AnimatedParticleSystemComponent()
+{
+	delete mBatch;
+}
+
 void AnimatedParticleSystemComponent::EmitParticle(float lifetime, float speed, const Vector2 &offsetPosition)
 {
     for (auto p : mParticles)
@@ -116,4 +144,35 @@ void AnimatedParticleSystemComponent::EmitParticleAt(float lifetime, float speed
 		}
 	}
     
-}
\ No newline at end of file
+}
+
+const Vector4 &AnimatedParticleSystemComponent::GetFrameAt(float normalizedAge) const
+{
+	float time = Math::Clamp(normalizedAge, 0.0f, 1.0f) * mTotalDuration;
+	for (const auto &frame : mFrames)
+	{
+		if (time < frame.duration) return frame.uv;
+		time -= frame.duration;
+	}
+	return mFrames.back().uv;
+}
+
+void AnimatedParticleSystemComponent::Draw(Renderer *renderer)
+{
+	if (!mIsVisible || !mTexture) return;
+
+	Vector2 size(static_cast<float>(GameConstants::TILE_SIZE), static_cast<float>(GameConstants::TILE_SIZE));
+
+	mBatch->Clear();
+	for (auto p : mParticles)
+	{
+		if (p->IsDead()) continue;
+
+		const Vector4 &texRect = mFrames.empty() ? mTextureRect : GetFrameAt(p->GetNormalizedAge());
+		// Same flips the AnimatorComponent took from the scale signs
+		Vector2 flippedSize(p->GetScale().x < 0.0f ? -size.x : size.x, p->GetScale().y < 0.0f ? -size.y : size.y);
+		mBatch->AddParticle(p->GetPosition(), p->GetRotation(), flippedSize, texRect, mColor, 1.0f);
+	}
+
+	renderer->DrawParticles(mBatch, mTexture.Get(), GetGame()->GetCameraPos());
+}
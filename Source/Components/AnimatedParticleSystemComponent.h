@@ -7,29 +7,48 @@
 class AnimatedParticle : public Actor
 {
 public:
-	AnimatedParticle(class Game *game, bool hasCollider, std::string particleAnimName);
+	// Particles only move and collide, their system draws all of them at once
+	AnimatedParticle(class Game *game, bool hasCollider);
 
 	void OnUpdate(float deltaTime) override;
 
 	bool IsDead() const { return mIsDead; }
+	// 0 when awoken, 1 when its lifetime runs out
+	float GetNormalizedAge() const { return 1.0f - mLifeTime / mTotalLifeTime; }
 	void Awake(const Vector2 &position, float rotation, float lifetime = 1.0f, bool flipV = false);
 	void Kill() override;
 private:
 	float mLifeTime;
+	float mTotalLifeTime;
 	bool mIsDead;
 
-	class AnimatorComponent *mAnimatorComponent;
 	class RigidBodyComponent *mRigidBodyComponent;
 	class ColliderComponent *mColliderComponent;
 };
 
-class AnimatedParticleSystemComponent : public Component
+class AnimatedParticleSystemComponent : public DrawComponent
 {
 public:
-	AnimatedParticleSystemComponent(class Actor *owner, std::string particlePath, bool hasCollider = true, int poolSize = 100, int updateOrder = 10);
+	// The animation file is read once here and shared by the whole pool
+	AnimatedParticleSystemComponent(class Actor *owner, std::string particlePath, bool hasCollider = true, int poolSize = 100, int drawOrder = 100);
+	~AnimatedParticleSystemComponent() override;
+
 	void EmitParticle(float lifetime, float speed, const Vector2 &offsetPosition = Vector2::Zero);
     void EmitParticleAt(float lifetime, float speed, const Vector2 &position, const float rotation, bool flipV = false);
+
+	// Each live particle shows the frame its age reaches, stretched over its lifetime
+	void Draw(class Renderer *renderer) override;
 	
 private:
+	const Vector4 &GetFrameAt(float normalizedAge) const;
+
 	std::vector<class AnimatedParticle *> mParticles;
+
+	TextureHandle mTexture;
+	// Where the sheet sits on its texture, the unit rect unless it was packed into the atlas
+	Vector4 mTextureRect;
+	std::vector<Sprite> mFrames;
+	float mTotalDuration;
+
+	class ParticleBatch *mBatch;
 };
\ No newline at end of file
@@ -17,6 +17,10 @@ public:
     virtual void ComponentDraw(class Renderer* renderer) {}
     // Debug draw for this component (if needed)
     virtual void DebugDraw(class Renderer *renderer);
+    // Contact events, only raised for colliders that report contacts
+    virtual void OnCollisionEnter(class ColliderComponent *other) {}
+    virtual void OnCollisionStay(class ColliderComponent *other) {}
+    virtual void OnCollisionExit(class ColliderComponent *other) {}
 
     int GetUpdateOrder() const { return mUpdateOrder; }
     class Actor *GetOwner() const { return mOwner; }
@@ -3,6 +3,7 @@
 #include "../../Game.h"
 #include "../../Json.h"
 #include "../../Renderer/Texture.h"
+#include "../../Renderer/TextureAtlas.h"
 #include <fstream>
 #include <map>
 
@@ -10,15 +11,37 @@ const std::string ANIMATION_DATA_PATH = "../Assets/Data/Animation/";
 
 AnimatorComponent::AnimatorComponent(class Actor *owner, const std::string &animationName,
 									 int width, int height, int drawOrder)
-	: DrawComponent(owner, drawOrder), mIsPaused(false), mSize(width, height), mTextureFactor(1.0f), mCurrentAnimation(nullptr), mLoopAnimName(""), mRemainingLoops(-1)
-	, mAnimSpeed(1.0f), mFrameTimer(0.0f), mCurrentFrameIndex(0), mAnimOffset(Vector2::Zero)
+	: DrawComponent(owner, drawOrder), mTextureRect(Vector4::UnitRect), mCurrentAnimation(nullptr), mFrameTimer(0.0f), mCurrentFrameIndex(0)
+	, mRemainingLoops(-1), mAnimSpeed(1.0f), mAnimOffset(Vector2::Zero), mIsPaused(false), mSize(width, height), mTextureFactor(1.0f)
 {
 	bool loaded = LoadAnimationData(animationName);
 	if (!loaded)
-		mSpriteTexture = mOwner->GetGame()->GetRenderer()->GetTexture("../Assets/Sprites/NoTexture/NoTexture.png");
+		mSpriteTexture = TextureHandle(mOwner->GetGame()->GetRenderer()->GetTextureRegion("../Assets/Sprites/NoTexture/NoTexture.png", mTextureRect));
 }
 
 bool AnimatorComponent::LoadAnimationData(const std::string &animationName)
+{
+	AnimationSheet sheet;
+	if (!LoadAnimationSheet(animationName, sheet))
+		return false;
+
+	mSpriteTexture = TextureHandle(mOwner->GetGame()->GetRenderer()->GetTextureRegion(sheet.texturePath, mTextureRect));
+	for (auto &sprite : sheet.sprites)
+		sprite.uv = TextureAtlas::RemapRect(sprite.uv, mTextureRect);
+	mSpriteSheetData = std::move(sheet.sprites);
+
+	for (const auto& [animName, indices] : sheet.animations)
+		AddAnimation(animName, indices);
+	if (mAnimations.empty())
+		for (auto spriteIndex = 0; spriteIndex < mSpriteSheetData.size(); ++spriteIndex)
+			AddAnimation(std::to_string(spriteIndex), { spriteIndex });
+
+	std::string baseAnim = !sheet.baseAnimation.empty() ? sheet.baseAnimation : mAnimations.begin()->first.GetString();
+	LoopAnimation(baseAnim);
+	return true;
+}
+
+bool AnimatorComponent::LoadAnimationSheet(const std::string &animationName, AnimationSheet &outSheet)
 {
 	std::ifstream animFile(ANIMATION_DATA_PATH + animationName + ".json");
 
@@ -35,15 +58,13 @@ bool AnimatorComponent::LoadAnimationData(const std::string &animationName)
 		return false;
 	}
 
-	std::string texturePath = animData["image"].get<std::string>();
-	if (texturePath.empty())
+	outSheet.texturePath = animData["image"].get<std::string>();
+	if (outSheet.texturePath.empty())
 	{
 		SDL_Log("No texture path specified in animation file: %s", (animationName).c_str());
 		return false;
 	}
 
-	mSpriteTexture = mOwner->GetGame()->GetRenderer()->GetTexture(texturePath);
-
 	std::string spriteSheetDataPath = animData["spriteSheetData"].get<std::string>();
 	if (spriteSheetDataPath.empty())
 	{
@@ -51,9 +72,9 @@ bool AnimatorComponent::LoadAnimationData(const std::string &animationName)
 		return false;
 	}
 
-	if (!LoadSpriteSheetData(spriteSheetDataPath))
+	if (!LoadSpriteSheetData(spriteSheetDataPath, outSheet.sprites))
 	{
-		SDL_Log("Failed to load sprite sheet data for %s", texturePath.c_str());
+		SDL_Log("Failed to load sprite sheet data for %s", outSheet.texturePath.c_str());
 		return false;
 	}
 
@@ -69,14 +90,11 @@ bool AnimatorComponent::LoadAnimationData(const std::string &animationName)
 			if (start <= end) for (int i = start; i <= end; ++i) indices.push_back(i);
 			else for (int i = start; i >= end; --i) indices.push_back(i);
 		}
-		AddAnimation(animName, indices);
+		outSheet.animations[animName] = indices;
 	}
-	if (mAnimations.empty())
-		for (auto spriteIndex = 0; spriteIndex < mSpriteSheetData.size(); ++spriteIndex)
-			AddAnimation(std::to_string(spriteIndex), { spriteIndex });
 
-	std::string baseAnim = animData.contains("base") ? animData["base"].get<std::string>() : mAnimations.begin()->first;
-	LoopAnimation(baseAnim);
+	if (animData.contains("base"))
+		outSheet.baseAnimation = animData["base"].get<std::string>();
 	return true;
 }
 
@@ -86,7 +104,7 @@ AnimatorComponent::~AnimatorComponent()
 	mSpriteSheetData.clear();
 }
 
-bool AnimatorComponent::LoadSpriteSheetData(const std::string &dataPath)
+bool AnimatorComponent::LoadSpriteSheetData(const std::string &dataPath, std::vector<Sprite> &outSprites)
 {
 	// Load sprite sheet data and return false if it fails
 	std::ifstream spriteSheetFile(dataPath);
@@ -147,7 +165,7 @@ bool AnimatorComponent::LoadSpriteSheetData(const std::string &dataPath)
 					static_cast<float>(w) / textureWidth, static_cast<float>(h) / textureHeight),
 			static_cast<float>(duration) / 1000.0f
 		};
-		mSpriteSheetData.push_back(sprite);
+		outSprites.push_back(sprite);
 	}
 
 	return true;
@@ -157,7 +175,7 @@ void AnimatorComponent::Draw(Renderer *renderer)
 {
 	if (mIsVisible && mSpriteTexture)
 	{
-		Vector4 texRect = Vector4::UnitRect;
+		Vector4 texRect = mTextureRect;
 
 		if (!mSpriteSheetData.empty())
 			texRect = mCurrentAnimation ? mCurrentAnimation->frames[mCurrentFrameIndex]->uv : mSpriteSheetData[0].uv;
@@ -170,7 +188,7 @@ void AnimatorComponent::Draw(Renderer *renderer)
 			mSize,
 			mOwner->GetRotation(),
 			Vector3(1.0f, 1.0f, 1.0f),
-			mSpriteTexture,
+			mSpriteTexture.Get(),
 			texRect,
 			mOwner->GetGame()->GetCameraPos(),
 			flipH,
@@ -179,6 +197,18 @@ void AnimatorComponent::Draw(Renderer *renderer)
 	}
 }
 
+unsigned int AnimatorComponent::GetSortTextureID() const
+{
+	return mSpriteTexture ? mSpriteTexture->GetTextureID() : 0;
+}
+
+bool AnimatorComponent::GetDrawBounds(Vector2 &outCenter, Vector2 &outSize) const
+{
+	outCenter = mOwner->GetPosition() + mAnimOffset;
+	outSize = mSize;
+	return true;
+}
+
 void AnimatorComponent::Update(float deltaTime)
 {
 	if (mIsPaused || mCurrentAnimation == nullptr) return;
@@ -198,7 +228,7 @@ void AnimatorComponent::Update(float deltaTime)
 	}
 }
 
-void AnimatorComponent::LoopAnimation(const std::string &name)
+void AnimatorComponent::LoopAnimation(AssetName name)
 {
 	if (mLoopAnimName == name) return;
 
@@ -206,7 +236,7 @@ void AnimatorComponent::LoopAnimation(const std::string &name)
 }
 
 
-void AnimatorComponent::PlayAnimation(const std::string &name, int loops, bool reset)
+void AnimatorComponent::PlayAnimation(AssetName name, int loops, bool reset)
 {
 	if (SetAnimation(name, reset)) mRemainingLoops = loops;
 }
@@ -217,7 +247,7 @@ void AnimatorComponent::ResetAnimation()
 	mFrameTimer = 0.0f;
 }
 
-bool AnimatorComponent::SetAnimation(const std::string &name, bool reset)
+bool AnimatorComponent::SetAnimation(AssetName name, bool reset)
 {
 	auto animIter = mAnimations.find(name);
 	if (animIter == mAnimations.end())
@@ -247,10 +277,10 @@ void AnimatorComponent::AddAnimation(const std::string &name, const std::vector<
 		animation.totalDuration += sprite->duration;
 	}
 	
-	mAnimations.emplace(name, animation);
+	mAnimations.emplace(AssetName(name), animation);
 }
 
-float AnimatorComponent::GetAnimationDuration(const std::string &name)
+float AnimatorComponent::GetAnimationDuration(AssetName name) const
 {
 	auto iter = mAnimations.find(name);
 	if (iter == mAnimations.end()) return 0.0f;
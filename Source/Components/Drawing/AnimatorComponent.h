@@ -2,6 +2,8 @@
 
 #include <unordered_map>
 #include "DrawComponent.h"
+#include "../../Renderer/TextureHandle.h"
+#include "../../AssetName.h"
 
 struct Sprite
 {
@@ -9,6 +11,15 @@ struct Sprite
     float duration;
 };
 
+// Everything an animation file describes, before it is bound to an animator
+struct AnimationSheet
+{
+    std::string texturePath;
+    std::vector<Sprite> sprites;
+    std::unordered_map<std::string, std::vector<int>> animations;
+    std::string baseAnimation;
+};
+
 struct Animation
 {
     std::vector<Sprite*> frames;
@@ -25,14 +36,20 @@ public:
 
     void Draw(Renderer *renderer) override;
     void Update(float deltaTime) override;
+    unsigned int GetSortTextureID() const override;
+    bool GetDrawBounds(Vector2 &outCenter, Vector2 &outSize) const override;
 
     // Use to change the speed of the animation
     void SetAnimSpeed(float speed) { mAnimSpeed = speed; }
 
-    // Set the current active animation
-    void LoopAnimation(const std::string &name);
-    void PlayAnimation(const std::string &name, int loops, bool reset = true);
-    void PlayAnimationOnce(const std::string &name, bool reset = true) { PlayAnimation(name, 1, reset); }
+    // Set the current active animation. Code running every frame should hold on to its AssetNames,
+    // the string overloads intern the name on each call
+    void LoopAnimation(AssetName name);
+    void PlayAnimation(AssetName name, int loops, bool reset = true);
+    void PlayAnimationOnce(AssetName name, bool reset = true) { PlayAnimation(name, 1, reset); }
+    void LoopAnimation(const std::string &name) { LoopAnimation(AssetName(name)); }
+    void PlayAnimation(const std::string &name, int loops, bool reset = true) { PlayAnimation(AssetName(name), loops, reset); }
+    void PlayAnimationOnce(const std::string &name, bool reset = true) { PlayAnimation(AssetName(name), 1, reset); }
 
     void ResetAnimation();
 
@@ -42,29 +59,37 @@ public:
     // Add an animation of the corresponding name to the animation map
     void AddAnimation(const std::string &name, const std::vector<int> &images);
 
-    float GetAnimationDuration(const std::string &name);
+    float GetAnimationDuration(AssetName name) const;
+    float GetAnimationDuration(const std::string &name) const { return GetAnimationDuration(AssetName(name)); }
     float GetCurrentAnimationDuration() const;
 
     void SetAnimOffset(const Vector2 &offset) { mAnimOffset = offset; }
     void SetSize(const Vector2 &size) { mSize = size; }
 
+    // Reads an animation file from the animation data folder, sprite sheet included
+    static bool LoadAnimationSheet(const std::string &animationName, AnimationSheet &outSheet);
+
+    // Parses an Aseprite sprite sheet into normalized frame rects, ordered by the number in each frame name
+    static bool LoadSpriteSheetData(const std::string &dataPath, std::vector<Sprite> &outSprites);
+
 private:
-    bool SetAnimation(const std::string &name, bool reset = true);
+    bool SetAnimation(AssetName name, bool reset = true);
 
     bool LoadAnimationData(const std::string &animationName);
-    bool LoadSpriteSheetData(const std::string &dataPath);
 
     // Sprite sheet texture
-    class Texture *mSpriteTexture;
+    TextureHandle mSpriteTexture;
+    // Where the sheet sits on the texture, the unit rect unless it was packed into the atlas
+    Vector4 mTextureRect;
 
     // Vector of sprites
     std::vector<Sprite> mSpriteSheetData;
 
     // Map of animation name to vector of textures corresponding to the animation
-    std::unordered_map<std::string, Animation> mAnimations;
+    std::unordered_map<AssetName, Animation> mAnimations;
 
     // Name of current animation
-    std::string mLoopAnimName;
+    AssetName mLoopAnimName;
 
     Animation *mCurrentAnimation;
 
@@ -3,7 +3,7 @@
 #include "../../Actors/Actor.h"
 
 DrawComponent::DrawComponent(class Actor *owner, int drawOrder)
-    : Component(owner), mDrawOrder(drawOrder), mIsVisible(true), mColor(Vector3::One)
+    : Component(owner), mDrawOrder(drawOrder), mLayer(RenderLayer::World), mIsVisible(true), mColor(Vector3::One)
 {
     mOwner->GetGame()->AddDrawable(this);
 }
@@ -16,3 +16,27 @@ DrawComponent::~DrawComponent()
 void DrawComponent::Draw(Renderer *renderer)
 {
 }
+
+bool DrawComponent::IsInView(const Vector2 &viewMin, const Vector2 &viewMax) const
+{
+    Vector2 center;
+    Vector2 size;
+    if (!GetDrawBounds(center, size)) return true;
+
+    Vector2 extents = size * 0.5f;
+    // Rotated quads can reach out to their half diagonal
+    if (mOwner->GetRotation() != 0.0f)
+    {
+        float radius = extents.Length();
+        extents = Vector2(radius, radius);
+    }
+
+    return center.x + extents.x >= viewMin.x && center.x - extents.x <= viewMax.x &&
+           center.y + extents.y >= viewMin.y && center.y - extents.y <= viewMax.y;
+}
+
+void DrawComponent::EmitRenderCommands(RenderQueue &queue)
+{
+    uint64_t key = RenderQueue::MakeKey(mLayer, mDrawOrder, GetSortTextureID(), mOwner->GetPosition().y);
+    queue.Push(key, this);
+}
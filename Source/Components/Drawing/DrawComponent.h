@@ -3,6 +3,7 @@
 #include "../../Math.h"
 #include "../../Renderer/Renderer.h"
 #include "../../Renderer/VertexArray.h"
+#include "../../Renderer/RenderQueue.h"
 #include <vector>
 #include <SDL.h>
 
@@ -16,11 +17,24 @@ public:
     virtual void Draw(Renderer *renderer);
     int GetDrawOrder() const { return mDrawOrder; }
 
+    // Adds the command that will call Draw, sorted by layer, draw order, texture and Y
+    virtual void EmitRenderCommands(RenderQueue &queue);
+    // Texture used for sorting, 0 when untextured
+    virtual unsigned int GetSortTextureID() const { return 0; }
+
+    // Center and size of what Draw covers. Returns false when unknown, so the drawable is never culled
+    virtual bool GetDrawBounds(Vector2 &outCenter, Vector2 &outSize) const { return false; }
+    bool IsInView(const Vector2 &viewMin, const Vector2 &viewMax) const;
+
+    void SetLayer(RenderLayer layer) { mLayer = layer; }
+    RenderLayer GetLayer() const { return mLayer; }
+
     void SetVisible(bool visible) { mIsVisible = visible; }
     void SetColor(const Vector3 &color) { mColor = color; }
 
 protected:
     int mDrawOrder;
+    RenderLayer mLayer;
     bool mIsVisible;
     Vector3 mColor;
 };
@@ -19,4 +19,11 @@ void RectComponent::Draw(class Renderer *renderer)
         renderer->DrawRect(mOwner->GetPosition(), Vector2(mWidth, mHeight), mOwner->GetRotation(),
                            mColor, GetGame()->GetCameraPos(), mMode);
     }
-}
\ No newline at end of file
+}
+
+bool RectComponent::GetDrawBounds(Vector2 &outCenter, Vector2 &outSize) const
+{
+    outCenter = mOwner->GetPosition();
+    outSize = Vector2(static_cast<float>(mWidth), static_cast<float>(mHeight));
+    return true;
+}
@@ -10,6 +10,7 @@ public:
     ~RectComponent();
 
     void Draw(class Renderer *renderer) override;
+    bool GetDrawBounds(Vector2 &outCenter, Vector2 &outSize) const override;
 
 private:
     int mWidth;
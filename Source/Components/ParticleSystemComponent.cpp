@@ -2,33 +2,29 @@
 #include "ParticleSystemComponent.h"
 #include "Physics/ColliderComponent.h"
 #include "Physics/RigidBodyComponent.h"
-#include "Drawing/RectComponent.h"
+#include "../Renderer/ParticleBatch.h"
 
-Particle::Particle(class Game *game, int width, int height, bool hasCollider)
-    : Actor(game), mDrawComponent(nullptr), mRigidBodyComponent(nullptr), mColliderComponent(nullptr), mIsDead(true), mLifeTime(1.0f)
+Particle::Particle(class Game *game, Collider *collider)
+    : Actor(game), mRigidBodyComponent(nullptr), mColliderComponent(nullptr), mIsDead(true), mLifeTime(1.0f)
 {
-    mDrawComponent = new RectComponent(this, width, height, RendererMode::TRIANGLES);
     mRigidBodyComponent = new RigidBodyComponent(this, 1.0f, 0.0f, true);
 
-    if (hasCollider)
+    if (collider)
     {
         CollisionFilter filter;
         filter.belongsTo = CollisionFilter::GroupMask({CollisionGroup::Environment});
         filter.collidesWith = CollisionFilter::GroupMask({CollisionGroup::Player, CollisionGroup::Enemy, CollisionGroup::Environment});
         
-        Collider *collider = new AABBCollider(width, height);
         mColliderComponent = new ColliderComponent(this, 0, 0, collider, filter);
     }
 
     SetState(ActorState::Paused);
-    mDrawComponent->SetVisible(false);
 }
 
 void Particle::Kill()
 {
     mIsDead = true;
     SetState(ActorState::Paused);
-    mDrawComponent->SetVisible(false);
     if (mColliderComponent) mColliderComponent->SetEnabled(false);
 
     // Reset velocity
@@ -41,7 +37,6 @@ void Particle::Awake(const Vector2 &position, float rotation, float lifetime)
 
     mIsDead = false;
     SetState(ActorState::Active);
-    mDrawComponent->SetVisible(true);
     if (mColliderComponent) mColliderComponent->SetEnabled(true);
 
     SetPosition(position);
@@ -58,17 +53,25 @@ void Particle::OnUpdate(float deltaTime)
     }
 }
 
-ParticleSystemComponent::ParticleSystemComponent(class Actor *owner, int particleW, int particleH, int poolSize, int updateOrder, bool hasCollider)
-    : Component(owner, updateOrder)
+ParticleSystemComponent::ParticleSystemComponent(class Actor *owner, int particleW, int particleH, int poolSize, int drawOrder, bool hasCollider)
+    : DrawComponent(owner, drawOrder)
+    , mParticleSize(static_cast<float>(particleW), static_cast<float>(particleH))
+    , mBatch(new ParticleBatch(poolSize))
 {
     // Create a pool of particles
     for (int i = 0; i < poolSize; i++)
     {
-        auto *p = new Particle(owner->GetGame(), particleW, particleH, hasCollider);
+        Collider *collider = hasCollider ? new AABBCollider(particleW, particleH) : nullptr;
+        auto *p = new Particle(owner->GetGame(), collider);
         mParticles.push_back(p);
     }
 }
 
+ParticleSystemComponent::~ParticleSystemComponent()
+{
+    delete mBatch;
+}
+
 void ParticleSystemComponent::EmitParticle(float lifetime, float speed, const Vector2 &offsetPosition)
 {
     for (auto p : mParticles)
@@ -87,4 +90,18 @@ void ParticleSystemComponent::EmitParticle(float lifetime, float speed, const Ve
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+void ParticleSystemComponent::Draw(Renderer *renderer)
+{
+    if (!mIsVisible) return;
+
+    mBatch->Clear();
+    for (auto p : mParticles)
+    {
+        if (!p->IsDead())
+            mBatch->AddParticle(p->GetPosition(), p->GetRotation(), mParticleSize, Vector4::UnitRect, mColor, 0.0f);
+    }
+
+    renderer->DrawParticles(mBatch, nullptr, GetGame()->GetCameraPos());
+}
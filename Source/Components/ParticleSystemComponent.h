@@ -1,13 +1,15 @@
 #pragma once
 
 #include "../Actors/Actor.h"
-#include "Component.h"
+#include "Drawing/DrawComponent.h"
 #include <vector>
 
 class Particle : public Actor
 {
 public:
-    Particle(class Game *game, int width, int height, bool hasCollider);
+    // Particles only move and collide, their system draws all of them at once.
+    // The collider goes to the particle's ColliderComponent, particles without one pass nullptr
+    Particle(class Game *game, class Collider *collider);
 
     void OnUpdate(float deltaTime) override;
 
@@ -19,18 +21,24 @@ private:
     float mLifeTime;
     bool mIsDead;
 
-    class DrawComponent *mDrawComponent;
     class RigidBodyComponent *mRigidBodyComponent;
     class ColliderComponent *mColliderComponent;
 };
 
-class ParticleSystemComponent : public Component
+class ParticleSystemComponent : public DrawComponent
 {
 
 public:
-    ParticleSystemComponent(class Actor *owner, int partibleW, int particleH, int poolSize = 100, int updateOrder = 10, bool hasCollider = true);
+    ParticleSystemComponent(class Actor *owner, int partibleW, int particleH, int poolSize = 100, int drawOrder = 100, bool hasCollider = true);
+    ~ParticleSystemComponent() override;
+
     void EmitParticle(float lifetime, float speed, const Vector2 &offsetPosition = Vector2::Zero);
 
+    // Live particles go into the instance buffer and are drawn with one call
+    void Draw(class Renderer *renderer) override;
+
 private:
     std::vector<class Particle *> mParticles;
+    Vector2 mParticleSize;
+    class ParticleBatch *mBatch;
 };
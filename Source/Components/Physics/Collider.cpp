@@ -1,6 +1,7 @@
 #include "Collider.h"
 #include "Physics.h"
 #include "../../Game.h"
+#include "../../GameConstants.h"
 
 bool Collider::CheckCollision(const Collider* other)
 {
@@ -8,10 +9,24 @@ bool Collider::CheckCollision(const Collider* other)
 	return CheckCollisionAt(&pos, other);
 }
 
-std::vector<ColliderComponent*> Collider::GetOverlappingColliders()
+bool Collider::CheckCollisionAt(Vector2* newPosition, const Collider* other) const
+{
+	if (this == other || !other) return false;
+
+	return Physics::CheckPair(this, *newPosition, other, other->GetComponent()->GetPosition());
+}
+
+void Collider::GetOverlappingColliders(std::vector<ColliderComponent*>& outHits) const
 {
 	auto pos = mComponent->GetPosition();
-	return GetOverlappingCollidersAt(&pos);
+	GetOverlappingCollidersAt(&pos, outHits);
+}
+
+void Collider::GetOverlappingCollidersAt(Vector2* newPosition, std::vector<ColliderComponent*>& outHits) const
+{
+	outHits.clear();
+	Physics::ForEachOverlappingCollider(mComponent->GetGame(), this, *newPosition, mComponent->GetFilter(),
+										[&outHits](ColliderComponent* c) { Physics::PushBackTracked(outHits, c); });
 }
 
 Vector2 AABBCollider::GetMinAt(Vector2 position) const
@@ -24,121 +39,111 @@ Vector2 AABBCollider::GetMaxAt(Vector2 position) const
 	return Vector2(position.x + mHalfDimensions.x, position.y + mHalfDimensions.y);
 }
 
-void AABBCollider::SolveCollisions(const RigidBodyComponent* rigidBody)
+void AABBCollider::SetSize(Vector2 size)
 {
-	auto overlappingColliders = Physics::GetOverlappingColliders(GetComponent()->GetGame(), this);
-
-	for (auto other : overlappingColliders)
-	{
-		auto otherAABB = dynamic_cast<AABBCollider*>(other->GetCollider());
-		if (!otherAABB) continue;
-
-		float minXOverlap = GetMinHorizontalOverlap(otherAABB);
-		float minYOverlap = GetMinVerticalOverlap(otherAABB);
-
-		if (Math::Abs(minXOverlap) < Math::Abs(minYOverlap))
-			ResolveHorizontalCollisions(const_cast<RigidBodyComponent*>(rigidBody), minXOverlap);
-		else
-			ResolveVerticalCollisions(const_cast<RigidBodyComponent*>(rigidBody), minYOverlap);
-	}
+	mHalfDimensions = size * 0.5f;
+	if (mComponent) mComponent->OnShapeChanged();
 }
 
-bool AABBCollider::CheckCollisionAt(Vector2* newPosition, const Collider* other) const
+void AABBCollider::GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const
 {
-	if (this == other) return false;
-
-	if (const AABBCollider* aabb = dynamic_cast<const AABBCollider*>(other))
-		return Physics::CheckAABBAABB(this, aabb, newPosition);
-	else if (const CircleCollider* circle = dynamic_cast<const CircleCollider*>(other))
-		return Physics::CheckAABBCircle(this, circle, newPosition);
-	else if (const PolygonCollider* poly = dynamic_cast<const PolygonCollider*>(other))
-		return Physics::CheckPolygonAABB(poly, this, nullptr, newPosition);
-
-	return false;
+	outMin = GetMinAt(position);
+	outMax = GetMaxAt(position);
 }
 
-bool CircleCollider::CheckCollisionAt(Vector2* newPosition, const Collider* other) const
+void CircleCollider::SetRadius(float radius)
 {
-	if (this == other) return false;
-	
-	if (const CircleCollider* circle = dynamic_cast<const CircleCollider*>(other))
-		return Physics::CheckCircleCircle(this, circle, newPosition);
-	else if (const AABBCollider* aabb = dynamic_cast<const AABBCollider*>(other))
-		return Physics::CheckAABBCircle(aabb, this, nullptr, newPosition);
-	else if (const PolygonCollider* poly = dynamic_cast<const PolygonCollider*>(other))
-		SDL_Log("Circle-Polygon collision not implemented yet");
+	mRadius = radius;
+	if (mComponent) mComponent->OnShapeChanged();
+}
 
-	return false;
+void CircleCollider::GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const
+{
+	outMin = Vector2(position.x - mRadius, position.y - mRadius);
+	outMax = Vector2(position.x + mRadius, position.y + mRadius);
 }
 
-bool PolygonCollider::CheckCollisionAt(Vector2* newPosition, const Collider* other) const
+PolygonCollider::PolygonCollider(const std::vector<Vector2>& vertices)
+	: Collider(ColliderShape::Polygon)
+	, mVertices(vertices)
+	, mBaseVertices(vertices)
+	, mForward(Vector2(1.0f, 0.0f))
 {
-	if (this == other) return false;
+	// SAT tests copy the vertices into a FixedPolygon, anything past its capacity would be dropped
+	if (vertices.size() > FixedPolygon::MAX_VERTICES)
+		SDL_Log("PolygonCollider has %zu vertices, only the first %d are used for collision", vertices.size(), FixedPolygon::MAX_VERTICES);
+}
 
-	if (const PolygonCollider* poly = dynamic_cast<const PolygonCollider*>(other))
-		return Physics::CheckPolygonPolygon(this, poly, newPosition);
-	else if (const AABBCollider* aabb = dynamic_cast<const AABBCollider*>(other))
-		return Physics::CheckPolygonAABB(this, aabb, newPosition);
-	else if (const CircleCollider* circle = dynamic_cast<const CircleCollider*>(other))
-		SDL_Log("Polygon-Circle collision not implemented yet");
+void PolygonCollider::GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const
+{
+	outMin = outMax = position;
+	if (mVertices.empty()) return;
 
-	return false;
+	outMin = outMax = mVertices[0] + position;
+	for (const auto& vertex : mVertices)
+	{
+		outMin.x = Math::Min(outMin.x, vertex.x + position.x);
+		outMin.y = Math::Min(outMin.y, vertex.y + position.y);
+		outMax.x = Math::Max(outMax.x, vertex.x + position.x);
+		outMax.y = Math::Max(outMax.y, vertex.y + position.y);
+	}
 }
 
-std::vector<ColliderComponent*> AABBCollider::GetOverlappingCollidersAt(Vector2* newPosition) const
+void AABBCollider::SolveCollisions(const RigidBodyComponent* rigidBody)
 {
-	std::vector<ColliderComponent*> hitColliders;
-	auto colliderComponents = mComponent->GetOwner()->GetGame()->GetColliders();
-	CollisionFilter filter = mComponent->GetFilter();
-	for (auto c : colliderComponents)
+	Physics::GetOverlappingColliders(GetComponent()->GetGame(), this, mOverlapping);
+
+	for (auto other : mOverlapping)
 	{
-		if (!c->IsEnabled()) continue;
-		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) continue;
+		if (other->GetCollider()->GetShape() != ColliderShape::AABB) continue;
+		auto otherAABB = static_cast<AABBCollider*>(other->GetCollider());
+
+		ResolveAgainstBox(const_cast<RigidBodyComponent*>(rigidBody), otherAABB->GetMin(), otherAABB->GetMax());
 
-		if (CheckCollisionAt(newPosition, c->GetCollider())) hitColliders.push_back(c);
+		// A sleeping body we ran into has to resolve its side of the contact too
+		auto otherBody = other->GetOwner()->GetComponent<RigidBodyComponent>();
+		if (otherBody && !otherBody->IsAwake()) otherBody->WakeUp();
 	}
 
-	return hitColliders;
+	ResolveTileCollisions(const_cast<RigidBodyComponent*>(rigidBody));
 }
 
-std::vector<ColliderComponent*> CircleCollider::GetOverlappingCollidersAt(Vector2* newPosition) const
+void AABBCollider::ResolveAgainstBox(RigidBodyComponent *rigidBody, const Vector2& bMin, const Vector2& bMax)
 {
-	std::vector<ColliderComponent*> hitColliders;
-	auto colliderComponents = mComponent->GetOwner()->GetGame()->GetColliders();
-	CollisionFilter filter = mComponent->GetFilter();
-	for (auto c : colliderComponents)
-	{
-		if (!c->IsEnabled()) continue;
-		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) continue;
-
-		if (CheckCollisionAt(newPosition, c->GetCollider())) hitColliders.push_back(c);
-	}
+	float minXOverlap = GetMinHorizontalOverlap(bMin, bMax);
+	float minYOverlap = GetMinVerticalOverlap(bMin, bMax);
 
-	return hitColliders;
+	if (Math::Abs(minXOverlap) < Math::Abs(minYOverlap))
+		ResolveHorizontalCollisions(rigidBody, minXOverlap);
+	else
+		ResolveVerticalCollisions(rigidBody, minYOverlap);
 }
 
-std::vector<ColliderComponent*> PolygonCollider::GetOverlappingCollidersAt(Vector2* newPosition) const
+void AABBCollider::ResolveTileCollisions(RigidBodyComponent *rigidBody)
 {
-	std::vector<ColliderComponent*> hitColliders;
-	auto colliderComponents = mComponent->GetOwner()->GetGame()->GetColliders();
-	CollisionFilter filter = mComponent->GetFilter();
-	for (auto c : colliderComponents)
-	{
-		if (!c->IsEnabled()) continue;
-		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) continue;
+	if (GameConstants::STATIC_COLLISION_MODE != StaticCollisionMode::TileMap) return;
 
-		if (CheckCollisionAt(newPosition, c->GetCollider())) hitColliders.push_back(c);
-	}
+	const TileCollisionMap& tileMap = mComponent->GetGame()->GetTileCollisionMap();
+	if (!CollisionFilter::ShouldCollide(mComponent->GetFilter(), tileMap.GetFilter())) return;
+
+	// Only the handful of tiles under the box can touch it. Overlap is re-checked per tile
+	// since resolving against one wall can already push us out of its neighbour
+	tileMap.ForEachSolidTile(GetMin(), GetMax(), [&](int x, int y)
+	{
+		Vector2 tileMin = tileMap.GetTileMin(x, y);
+		Vector2 tileMax = tileMap.GetTileMax(x, y);
+		Vector2 min = GetMin();
+		Vector2 max = GetMax();
+		if (max.x <= tileMin.x || min.x >= tileMax.x || max.y <= tileMin.y || min.y >= tileMax.y) return;
 
-	return hitColliders;
+		ResolveAgainstBox(rigidBody, tileMin, tileMax);
+	});
 }
 
-float AABBCollider::GetMinVerticalOverlap(AABBCollider *b) const
+float AABBCollider::GetMinVerticalOverlap(const Vector2& bMin, const Vector2& bMax) const
 {
 	Vector2 aMin = this->GetMin();
 	Vector2 aMax = this->GetMax();
-	Vector2 bMin = b->GetMin();
-	Vector2 bMax = b->GetMax();
 
 	float overlapTop = aMax.y - bMin.y;
 
@@ -149,12 +154,10 @@ float AABBCollider::GetMinVerticalOverlap(AABBCollider *b) const
 	else return -overlapBottom;
 }
 
-float AABBCollider::GetMinHorizontalOverlap(AABBCollider *b) const
+float AABBCollider::GetMinHorizontalOverlap(const Vector2& bMin, const Vector2& bMax) const
 {
 	Vector2 aMin = this->GetMin();
 	Vector2 aMax = this->GetMax();
-	Vector2 bMin = b->GetMin();
-	Vector2 bMax = b->GetMax();
 
 	float overlapRight = aMax.x - bMin.x;
 
@@ -226,4 +229,6 @@ void PolygonCollider::SetForward(Vector2 forward)
 		Vector2 rotated = rotation * baseVertex;
 		mVertices.push_back(rotated);
 	}
+
+	if (mComponent) mComponent->OnShapeChanged();
 }
\ No newline at end of file
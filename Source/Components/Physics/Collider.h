@@ -4,37 +4,56 @@
 #include "ColliderComponent.h"
 #include <vector>
 
+// Shape tag used to pick narrowphase routines without RTTI
+enum class ColliderShape
+{
+	AABB,
+	Circle,
+	Polygon,
+	Count
+};
+
 class Collider
 {
 public:
+	explicit Collider(ColliderShape shape) : mShape(shape) {}
 	virtual ~Collider() = default;
 
+	ColliderShape GetShape() const { return mShape; }
+
 	ColliderComponent* GetComponent() const { return mComponent; }
 	void SetComponent(ColliderComponent* component) { mComponent = component; }
 
 	bool CheckCollision(const Collider* other);
-	std::vector<ColliderComponent*> GetOverlappingColliders();
+	bool CheckCollisionAt(Vector2* newPosition, const Collider* other) const;
+
+	// Hits are written into outHits (cleared first), see Physics::GetOverlappingColliders
+	void GetOverlappingColliders(std::vector<ColliderComponent*>& outHits) const;
+	void GetOverlappingCollidersAt(Vector2* newPosition, std::vector<ColliderComponent*>& outHits) const;
 
-	virtual bool CheckCollisionAt(Vector2* newPosition, const Collider* other) const = 0;
-	virtual std::vector<ColliderComponent*> GetOverlappingCollidersAt(Vector2* newPosition) const = 0;
 	virtual void SolveCollisions(const RigidBodyComponent* rigidBody) = 0;
 	virtual void DebugDraw(class Renderer* renderer) = 0;
 
+	// World-space bounding box of the collider if it were at the given position
+	virtual void GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const = 0;
+
 protected:
-	ColliderComponent *mComponent;
+	ColliderComponent *mComponent = nullptr;
+
+private:
+	ColliderShape mShape;
 };
 
 class AABBCollider : public Collider
 {
 public:
-	AABBCollider(float width, float height) : mHalfDimensions(width / 2.0f, height / 2.0f) {}
+	AABBCollider(float width, float height) : Collider(ColliderShape::AABB), mHalfDimensions(width / 2.0f, height / 2.0f) {}
 
-	bool CheckCollisionAt(Vector2* newPosition, const Collider* other) const override;
-	std::vector<ColliderComponent*> GetOverlappingCollidersAt(Vector2* newPosition) const override;
 	void SolveCollisions(const RigidBodyComponent* rigidBody) override;
 	void DebugDraw(class Renderer* renderer) override;
+	void GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const override;
 
-	void SetSize(Vector2 size) { mHalfDimensions = size * 0.5f; }
+	void SetSize(Vector2 size);
 
 	Vector2 GetMinAt(Vector2 position) const;
 	Vector2 GetMaxAt(Vector2 position) const;
@@ -45,27 +64,31 @@ public:
 	Vector2 GetHalfDimensions() const { return mHalfDimensions; }
 
 private:
-	float GetMinVerticalOverlap(AABBCollider *b) const;
-	float GetMinHorizontalOverlap(AABBCollider *b) const;
+	float GetMinVerticalOverlap(const Vector2& bMin, const Vector2& bMax) const;
+	float GetMinHorizontalOverlap(const Vector2& bMin, const Vector2& bMax) const;
 
+	void ResolveAgainstBox(RigidBodyComponent *rigidBody, const Vector2& bMin, const Vector2& bMax);
+	void ResolveTileCollisions(RigidBodyComponent *rigidBody);
 	void ResolveHorizontalCollisions(RigidBodyComponent *rigidBody, const float minOverlap);
 	void ResolveVerticalCollisions(RigidBodyComponent *rigidBody, const float minOverlap);
 
 	Vector2 mHalfDimensions;
+
+	// Reused every solve so moving bodies don't allocate each frame
+	std::vector<ColliderComponent*> mOverlapping;
 };
 
 class CircleCollider : public Collider
 {
 public:
-	CircleCollider(float radius) : mRadius(radius) {}
+	CircleCollider(float radius) : Collider(ColliderShape::Circle), mRadius(radius) {}
 
-	bool CheckCollisionAt(Vector2* newPosition, const Collider* other) const override;
-	std::vector<ColliderComponent*> GetOverlappingCollidersAt(Vector2* newPosition) const override;
 	void SolveCollisions(const RigidBodyComponent* rigidBody) override {}
 	void DebugDraw(class Renderer* renderer) override;
+	void GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const override;
 
 	float GetRadius() const { return mRadius; }
-	void SetRadius(float radius) { mRadius = radius; }
+	void SetRadius(float radius);
 
 private:
 	float mRadius;
@@ -74,12 +97,11 @@ private:
 class PolygonCollider : public Collider
 {
 	public:
-		PolygonCollider(const std::vector<Vector2>& vertices) : mVertices(vertices), mBaseVertices(vertices), mForward(Vector2(1.0f, 0.0f)) {}
+		PolygonCollider(const std::vector<Vector2>& vertices);
 
-		bool CheckCollisionAt(Vector2* newPosition, const Collider* other) const override;
-		std::vector<ColliderComponent*> GetOverlappingCollidersAt(Vector2* newPosition) const override;
 		void SolveCollisions(const RigidBodyComponent* rigidBody) override {}
 		void DebugDraw(class Renderer* renderer) override;
+		void GetBoundsAt(const Vector2& position, Vector2& outMin, Vector2& outMax) const override;
 
 		void SetForward(Vector2 forward);
 
@@ -1,6 +1,7 @@
 #include "ColliderComponent.h"
 #include "../../Game.h"
 #include "CollisionFilter.h"
+#include "Collider.h"
 
 ColliderComponent::ColliderComponent(class Actor *owner, int dx, int dy, Collider* collider, CollisionFilter filter, bool isStatic, int updateOrder)
 	: Component(owner, updateOrder)
@@ -11,6 +12,7 @@ ColliderComponent::ColliderComponent(class Actor *owner, int dx, int dy, Collide
 {
 	if (mCollider) mCollider->SetComponent(this);
 	GetGame()->AddCollider(this);
+	SyncBroadphase();
 }
 
 ColliderComponent::ColliderComponent(class Actor *owner, Vector2 offset, Collider* collider, bool isStatic, int updateOrder)
@@ -21,6 +23,7 @@ ColliderComponent::ColliderComponent(class Actor *owner, Vector2 offset, Collide
 {
 	if (mCollider) mCollider->SetComponent(this);
 	GetGame()->AddCollider(this);
+	SyncBroadphase();
 }
 
 ColliderComponent::~ColliderComponent()
@@ -30,9 +33,10 @@ ColliderComponent::~ColliderComponent()
 
 void ColliderComponent::DetectCollisions(RigidBodyComponent *rigidBody)
 {
-	if (mIsStatic || !mIsEnabled) return;
+	if (!mIsStatic && mIsEnabled) mCollider->SolveCollisions(rigidBody);
 
-	mCollider->SolveCollisions(rigidBody);
+	// The owner just moved, so refresh our cells before anyone else queries this frame
+	SyncBroadphase();
 }
 
 void ColliderComponent::DebugDraw(class Renderer *renderer)
@@ -45,6 +49,14 @@ void ColliderComponent::DebugDraw(class Renderer *renderer)
 void ColliderComponent::SetOffset(Vector2 offset)
 {
 	mOffset = offset;
+	mContactsDirty = true;
+	SyncBroadphase();
+}
+
+void ColliderComponent::SetFilter(CollisionFilter filter)
+{
+	mFilter = filter;
+	mContactsDirty = true;
 }
 
 bool ColliderComponent::ShouldCollideWith(ColliderComponent* other) const
@@ -60,4 +72,74 @@ void ColliderComponent::SetCollider(Collider* collider)
 {
 	mCollider = collider;
 	if (mCollider) mCollider->SetComponent(this);
+	mContactsDirty = true;
+	SyncBroadphase();
+}
+
+void ColliderComponent::OnShapeChanged()
+{
+	mContactsDirty = true;
+	SyncBroadphase();
+}
+
+void ColliderComponent::SetReportsContacts(bool reportsContacts, bool isTrigger)
+{
+	mIsTrigger = isTrigger;
+	if (mReportsContacts == reportsContacts) return;
+
+	mReportsContacts = reportsContacts;
+	if (mReportsContacts) GetGame()->GetContactManager().AddReporter(this);
+	else GetGame()->GetContactManager().RemoveReporter(this);
+}
+
+bool ColliderComponent::HasMovedSinceContactStep(unsigned int step)
+{
+	if (mContactStep == step) return mMovedThisStep;
+
+	Vector2 position = GetPosition();
+	mMovedThisStep = mContactsDirty || position.x != mContactPosition.x || position.y != mContactPosition.y;
+	mContactPosition = position;
+	mContactStep = step;
+	mContactsDirty = false;
+
+	return mMovedThisStep;
+}
+
+void ColliderComponent::RaiseContactEvent(ContactEvent event, ColliderComponent* other)
+{
+	// Callbacks may add components to the owner, so iterate over a copy
+	std::vector<Component*> components = mOwner->GetComponents();
+
+	switch (event)
+	{
+	case ContactEvent::Enter:
+		for (auto component : components)
+			component->OnCollisionEnter(other);
+		mOwner->OnCollisionEnter(other);
+		break;
+	case ContactEvent::Stay:
+		for (auto component : components)
+			component->OnCollisionStay(other);
+		mOwner->OnCollisionStay(other);
+		break;
+	case ContactEvent::Exit:
+		for (auto component : components)
+			component->OnCollisionExit(other);
+		mOwner->OnCollisionExit(other);
+		break;
+	}
+}
+
+void ColliderComponent::SyncBroadphase()
+{
+	auto& grid = GetGame()->GetColliderGrid();
+	if (!mCollider)
+	{
+		grid.Remove(this, mGridProxy);
+		return;
+	}
+
+	Vector2 min, max;
+	mCollider->GetBoundsAt(GetPosition(), min, max);
+	grid.Update(this, mGridProxy, min, max);
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "../../Math.h"
 #include "CollisionFilter.h"
 #include "RigidBodyComponent.h"
+#include "SpatialGrid.h"
+#include "ContactManager.h"
 #include "../../Actors/Actor.h"
 
 class Collider;
@@ -21,9 +23,10 @@ public:
 	
 	Vector2 GetPosition() const { return mOwner->GetPosition() + mOffset; }
 	Collider* GetCollider() const { return mCollider; }
+	bool IsStatic() const { return mIsStatic; }
 
 	CollisionFilter GetFilter() const { return mFilter; }
-	void SetFilter(CollisionFilter filter) { mFilter = filter; }
+	void SetFilter(CollisionFilter filter);
 
 	void SetCollider(Collider* collider);
     
@@ -32,6 +35,23 @@ public:
 	void DebugDraw(class Renderer *renderer) override;
 	void SetDebugDrawIfDisabled(bool draw) { mDebugDrawIfDisabled = draw; }
 
+	// Broadphase
+	void SyncBroadphase();
+	GridProxy& GetGridProxy() { return mGridProxy; }
+
+	// Called by the collider when its size or orientation changes
+	void OnShapeChanged();
+
+	// Contact events (OnCollisionEnter/Stay/Exit on the owner and its components).
+	// A trigger only needs its own filter to accept the other collider
+	void SetReportsContacts(bool reportsContacts, bool isTrigger = false);
+	bool ReportsContacts() const { return mReportsContacts; }
+	bool IsTrigger() const { return mIsTrigger; }
+
+	bool HasMovedSinceContactStep(unsigned int step);
+	void MarkContactsDirty() { mContactsDirty = true; }
+	void RaiseContactEvent(ContactEvent event, ColliderComponent* other);
+
 private:
 
 	bool ShouldCollideWith(ColliderComponent* other) const;
@@ -42,4 +62,14 @@ private:
 	bool mDebugDrawIfDisabled = false;
 
 	CollisionFilter mFilter;
+	GridProxy mGridProxy;
+
+	bool mReportsContacts = false;
+	bool mIsTrigger = false;
+
+	// Movement since the last contact step, evaluated at most once per step
+	Vector2 mContactPosition;
+	unsigned int mContactStep = 0;
+	bool mMovedThisStep = true;
+	bool mContactsDirty = true;
 };
\ No newline at end of file
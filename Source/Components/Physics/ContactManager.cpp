@@ -0,0 +1,214 @@
+#include "ContactManager.h"
+#include "ColliderComponent.h"
+#include "Collider.h"
+#include "../../Game.h"
+#include <algorithm>
+
+ContactManager::ContactManager()
+	: mStep(0)
+	, mTestedPairs(0)
+	, mSkippedPairs(0)
+{
+}
+
+void ContactManager::AddReporter(ColliderComponent* collider)
+{
+	for (auto& reporter : mReporters)
+		if (reporter.collider == collider) return;
+
+	mReporters.push_back(Reporter{collider, {}});
+
+	// Pairs found before we started tracking are unknown, so test everything on the first step
+	collider->MarkContactsDirty();
+}
+
+void ContactManager::RemoveReporter(ColliderComponent* collider)
+{
+	auto iter = std::find_if(mReporters.begin(), mReporters.end(),
+		[collider](const Reporter& reporter) { return reporter.collider == collider; });
+	if (iter != mReporters.end()) mReporters.erase(iter);
+
+	for (auto& event : mEvents)
+		if (event.self == collider) event.self = nullptr;
+}
+
+void ContactManager::RemoveCollider(ColliderComponent* collider)
+{
+	RemoveReporter(collider);
+
+	for (auto& reporter : mReporters)
+	{
+		auto& contacts = reporter.contacts;
+		contacts.erase(std::remove_if(contacts.begin(), contacts.end(),
+			[collider](const Contact& contact) { return contact.other == collider; }), contacts.end());
+	}
+
+	// Events already queued for this step must not reach a deleted collider
+	for (auto& event : mEvents)
+		if (event.other == collider) event.other = nullptr;
+}
+
+void ContactManager::Clear()
+{
+	for (auto& reporter : mReporters)
+	{
+		reporter.contacts.clear();
+		reporter.collider->MarkContactsDirty();
+	}
+
+	mEvents.clear();
+}
+
+void ContactManager::Step(Game* game)
+{
+	++mStep;
+	mTestedPairs = 0;
+	mSkippedPairs = 0;
+	mEvents.clear();
+
+	for (auto& reporter : mReporters)
+		StepReporter(game, reporter);
+
+	// Callbacks may add or remove reporters, so index instead of iterating
+	for (size_t i = 0; i < mEvents.size(); ++i)
+	{
+		PendingEvent event = mEvents[i];
+		if (!event.self || !event.other) continue;
+
+		event.self->RaiseContactEvent(event.type, event.other);
+	}
+	mEvents.clear();
+}
+
+void ContactManager::StepReporter(Game* game, Reporter& reporter)
+{
+	ColliderComponent* self = reporter.collider;
+	Collider* collider = self->GetCollider();
+	if (!collider || !self->IsEnabled())
+	{
+		ExitAll(reporter);
+		return;
+	}
+
+	bool selfMoved = self->HasMovedSinceContactStep(mStep);
+	Vector2 position = self->GetPosition();
+
+	Vector2 min, max;
+	collider->GetBoundsAt(position, min, max);
+
+	game->GetColliderGrid().Query(min, max, [&](ColliderComponent* other)
+	{
+		if (other == self || !other->GetCollider()) return;
+		if (!Accepts(self, other)) return;
+
+		Contact* contact = FindContact(reporter, other);
+
+		// Disabled colliders are never tested, only remembered so enabling them is noticed
+		if (!other->IsEnabled())
+		{
+			if (!contact)
+			{
+				reporter.contacts.push_back(Contact{other, mStep, false, false});
+				return;
+			}
+
+			contact->seenStep = mStep;
+			contact->otherEnabled = false;
+			if (contact->touching)
+			{
+				contact->touching = false;
+				mEvents.push_back(PendingEvent{ContactEvent::Exit, self, other});
+			}
+			return;
+		}
+
+		// Neither side changed since the last step, so the pair is still in the same state
+		bool otherMoved = other->HasMovedSinceContactStep(mStep);
+		bool otherEnabledNow = contact && !contact->otherEnabled;
+		if (!selfMoved && !otherMoved && !otherEnabledNow)
+		{
+			++mSkippedPairs;
+			if (contact)
+			{
+				contact->seenStep = mStep;
+				mEvents.push_back(PendingEvent{ContactEvent::Stay, self, other});
+			}
+			return;
+		}
+
+		++mTestedPairs;
+		if (!collider->CheckCollisionAt(&position, other->GetCollider())) return;
+
+		if (contact && contact->touching)
+		{
+			contact->seenStep = mStep;
+			mEvents.push_back(PendingEvent{ContactEvent::Stay, self, other});
+			return;
+		}
+
+		if (contact)
+		{
+			contact->seenStep = mStep;
+			contact->otherEnabled = true;
+			contact->touching = true;
+		}
+		else
+			reporter.contacts.push_back(Contact{other, mStep, true, true});
+
+		mEvents.push_back(PendingEvent{ContactEvent::Enter, self, other});
+	});
+
+	// Anything not touched this step has separated or left the query bounds
+	auto& contacts = reporter.contacts;
+	for (size_t i = 0; i < contacts.size();)
+	{
+		if (contacts[i].seenStep == mStep)
+		{
+			++i;
+			continue;
+		}
+
+		if (contacts[i].touching)
+			mEvents.push_back(PendingEvent{ContactEvent::Exit, self, contacts[i].other});
+		contacts[i] = contacts.back();
+		contacts.pop_back();
+	}
+}
+
+ContactManager::Contact* ContactManager::FindContact(Reporter& reporter, const ColliderComponent* other)
+{
+	for (auto& contact : reporter.contacts)
+		if (contact.other == other) return &contact;
+	return nullptr;
+}
+
+void ContactManager::ExitAll(Reporter& reporter)
+{
+	for (auto& contact : reporter.contacts)
+		if (contact.touching) mEvents.push_back(PendingEvent{ContactEvent::Exit, reporter.collider, contact.other});
+	reporter.contacts.clear();
+
+	// Whatever collider or enabled state it gets next, its pairs have to be tested again
+	reporter.collider->MarkContactsDirty();
+}
+
+bool ContactManager::Accepts(const ColliderComponent* self, const ColliderComponent* other)
+{
+	CollisionFilter selfFilter = self->GetFilter();
+	CollisionFilter otherFilter = other->GetFilter();
+
+	// Triggers only need their own filter to accept the other collider
+	if (self->IsTrigger())
+		return (selfFilter.collidesWith & otherFilter.belongsTo) != 0;
+
+	return CollisionFilter::ShouldCollide(selfFilter, otherFilter);
+}
+
+int ContactManager::GetContactCount() const
+{
+	int count = 0;
+	for (const auto& reporter : mReporters)
+		for (const auto& contact : reporter.contacts)
+			if (contact.touching) ++count;
+	return count;
+}
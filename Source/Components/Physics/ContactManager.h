@@ -0,0 +1,75 @@
+#pragma once
+#include <vector>
+
+class ColliderComponent;
+
+enum class ContactEvent
+{
+	Enter,
+	Stay,
+	Exit
+};
+
+// Keeps the touching pairs of every collider that reports contacts between frames and raises
+// OnCollisionEnter/Stay/Exit on their owners. A pair is only re-tested when one of its
+// colliders moved, changed shape/filter or was enabled since the last step, otherwise its state is kept.
+// Disabling either side of a pair raises Exit, enabling it again raises Enter if they still touch
+class ContactManager
+{
+public:
+	ContactManager();
+
+	void AddReporter(ColliderComponent* collider);
+	void RemoveReporter(ColliderComponent* collider);
+
+	// Forgets every pair involving a collider that is being destroyed (no Exit is raised)
+	void RemoveCollider(ColliderComponent* collider);
+
+	// Forgets every pair and queued event without raising Exit. Reporters stay registered,
+	// so persistent actors keep reporting in the next scene
+	void Clear();
+
+	// Refreshes all pairs, then dispatches the events once every query is done
+	void Step(class Game* game);
+
+	int GetContactCount() const;
+	int GetTestedPairs() const { return mTestedPairs; }
+	int GetSkippedPairs() const { return mSkippedPairs; }
+
+private:
+	struct Contact
+	{
+		ColliderComponent* other;
+		unsigned int seenStep;
+
+		// A disabled collider in range keeps a contact that is not touching, so the step
+		// it is enabled again is noticed and the pair tested even if nothing moved
+		bool otherEnabled;
+		bool touching;
+	};
+
+	struct Reporter
+	{
+		ColliderComponent* collider;
+		std::vector<Contact> contacts;
+	};
+
+	struct PendingEvent
+	{
+		ContactEvent type;
+		ColliderComponent* self;
+		ColliderComponent* other;
+	};
+
+	void StepReporter(class Game* game, Reporter& reporter);
+	static Contact* FindContact(Reporter& reporter, const ColliderComponent* other);
+	void ExitAll(Reporter& reporter);
+	static bool Accepts(const ColliderComponent* self, const ColliderComponent* other);
+
+	std::vector<Reporter> mReporters;
+	std::vector<PendingEvent> mEvents;
+	unsigned int mStep;
+
+	int mTestedPairs;
+	int mSkippedPairs;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "../../Math.h"
+#include <vector>
+
+// Convex polygon with inline storage, so SAT tests never touch the heap.
+// Coordinates are kept as separate x/y arrays and unused slots repeat the last vertex,
+// which lets projections run over a fixed MAX_VERTICES without changing min/max
+struct FixedPolygon
+{
+	static constexpr int MAX_VERTICES = 8;
+
+	float x[MAX_VERTICES];
+	float y[MAX_VERTICES];
+	int count = 0;
+
+	void Add(const Vector2& vertex)
+	{
+		if (count >= MAX_VERTICES) return;
+
+		for (int i = count; i < MAX_VERTICES; ++i)
+		{
+			x[i] = vertex.x;
+			y[i] = vertex.y;
+		}
+		++count;
+	}
+
+	Vector2 GetVertex(int i) const { return Vector2(x[i], y[i]); }
+
+	static FixedPolygon FromVertices(const std::vector<Vector2>& vertices, const Vector2& offset = Vector2::Zero)
+	{
+		FixedPolygon polygon;
+		for (const auto& vertex : vertices)
+			polygon.Add(vertex + offset);
+		return polygon;
+	}
+
+	static FixedPolygon FromBox(const Vector2& min, const Vector2& max)
+	{
+		FixedPolygon polygon;
+		polygon.Add(min);
+		polygon.Add(Vector2(max.x, min.y));
+		polygon.Add(max);
+		polygon.Add(Vector2(min.x, max.y));
+		return polygon;
+	}
+};
@@ -1,7 +1,7 @@
 #include "Physics.h"
 #include "ColliderComponent.h"
 #include "../../Game.h"
-#include "../ParticleSystemComponent.h"
+#include "../../GameConstants.h"
 #include "CollisionFilter.h"
 #include "Collider.h"
 #include <cmath>
@@ -42,15 +42,7 @@ bool Physics::CheckPolygonPolygon(const PolygonCollider* a, const PolygonCollide
 	auto posA = positionA ? *positionA : a->GetComponent()->GetPosition();
 	auto posB = positionB ? *positionB : b->GetComponent()->GetPosition();
 
-	std::vector<Vector2> polyA;
-	for (const auto& vertex : a->GetVertices())
-		polyA.push_back(vertex + posA);
-
-	std::vector<Vector2> polyB;
-	for (const auto& vertex : b->GetVertices())
-		polyB.push_back(vertex + posB);
-
-	return OverlapPolygons(polyA, polyB);
+	return OverlapPolygons(FixedPolygon::FromVertices(a->GetVertices(), posA), FixedPolygon::FromVertices(b->GetVertices(), posB));
 }
 
 bool Physics::CheckPolygonAABB(const PolygonCollider* poly, const AABBCollider* aabb, Vector2* positionPoly, Vector2* positionAABB)
@@ -58,72 +50,389 @@ bool Physics::CheckPolygonAABB(const PolygonCollider* poly, const AABBCollider*
 	auto posPoly = positionPoly ? *positionPoly : poly->GetComponent()->GetPosition();
 	auto posAABB = positionAABB ? *positionAABB : aabb->GetComponent()->GetPosition();
 
-	std::vector<Vector2> polygon;
-	for (const auto& vertex : poly->GetVertices())
-		polygon.push_back(vertex + posPoly);
-
-	Vector2 aabbMin = aabb->GetMinAt(posAABB);
-	Vector2 aabbMax = aabb->GetMaxAt(posAABB);
-	std::vector<Vector2> box = {
-		aabbMin,
-		Vector2(aabbMax.x, aabbMin.y),
-		aabbMax,
-		Vector2(aabbMin.x, aabbMax.y)
-	};
+	FixedPolygon polygon = FixedPolygon::FromVertices(poly->GetVertices(), posPoly);
+	FixedPolygon box = FixedPolygon::FromBox(aabb->GetMinAt(posAABB), aabb->GetMaxAt(posAABB));
 
 	return OverlapPolygons(polygon, box);
 }
 
-std::vector<ColliderComponent*> Physics::GetOverlappingColliders(Game* game, Collider* collider)
+bool Physics::CheckCirclePolygon(const CircleCollider* circle, const PolygonCollider* poly, Vector2* positionCircle, Vector2* positionPoly)
+{
+	auto posCircle = positionCircle ? *positionCircle : circle->GetComponent()->GetPosition();
+	auto posPoly = positionPoly ? *positionPoly : poly->GetComponent()->GetPosition();
+
+	return OverlapCirclePolygon(posCircle, circle->GetRadius(), FixedPolygon::FromVertices(poly->GetVertices(), posPoly));
+}
+
+// Narrowphase pair table, indexed by [shape of a][shape of b]
+namespace
 {
-	std::vector<ColliderComponent*> hitColliders;
-	auto colliderComponents = game->GetColliders();
-	CollisionFilter filter = collider->GetComponent()->GetFilter();
-	for (auto c : colliderComponents)
+	using PairTest = bool (*)(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB);
+
+	bool TestAABBAABB(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
 	{
-		if (!c->IsEnabled()) continue;
-		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) continue;
+		return Physics::CheckAABBAABB(static_cast<const AABBCollider*>(a), static_cast<const AABBCollider*>(b), posA, posB);
+	}
 
-		if (collider->CheckCollision(c->GetCollider())) hitColliders.push_back(c);
+	bool TestAABBCircle(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return Physics::CheckAABBCircle(static_cast<const AABBCollider*>(a), static_cast<const CircleCollider*>(b), posA, posB);
+	}
+
+	bool TestAABBPolygon(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return Physics::CheckPolygonAABB(static_cast<const PolygonCollider*>(b), static_cast<const AABBCollider*>(a), posB, posA);
+	}
+
+	bool TestCircleAABB(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return TestAABBCircle(b, posB, a, posA);
+	}
+
+	bool TestCircleCircle(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return Physics::CheckCircleCircle(static_cast<const CircleCollider*>(a), static_cast<const CircleCollider*>(b), posA, posB);
+	}
+
+	bool TestCirclePolygon(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return Physics::CheckCirclePolygon(static_cast<const CircleCollider*>(a), static_cast<const PolygonCollider*>(b), posA, posB);
 	}
 
-	return hitColliders;
+	bool TestPolygonAABB(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return TestAABBPolygon(b, posB, a, posA);
+	}
+
+	bool TestPolygonCircle(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return TestCirclePolygon(b, posB, a, posA);
+	}
+
+	bool TestPolygonPolygon(const Collider* a, Vector2* posA, const Collider* b, Vector2* posB)
+	{
+		return Physics::CheckPolygonPolygon(static_cast<const PolygonCollider*>(a), static_cast<const PolygonCollider*>(b), posA, posB);
+	}
+
+	constexpr int SHAPE_COUNT = static_cast<int>(ColliderShape::Count);
+
+	const PairTest PAIR_TESTS[SHAPE_COUNT][SHAPE_COUNT] = {
+		//  vs AABB          vs Circle          vs Polygon
+		{ TestAABBAABB,    TestAABBCircle,    TestAABBPolygon    }, // AABB
+		{ TestCircleAABB,  TestCircleCircle,  TestCirclePolygon  }, // Circle
+		{ TestPolygonAABB, TestPolygonCircle, TestPolygonPolygon }, // Polygon
+	};
 }
 
-std::vector<ColliderComponent*> Physics::ConeCast(Game *game, Vector2 origin, Vector2 direction, float angle, float radius, CollisionFilter filter)
+bool Physics::CheckPair(const Collider* a, Vector2 positionA, const Collider* b, Vector2 positionB)
 {
-	float radiusSq = radius * radius;
-	auto colliderComponents = game->GetColliders();
-	std::vector<Vector2> coneTriangle = GetConeVertices(origin, direction, angle, radius);
-	std::vector<ColliderComponent*> hitColliders;
-	for (auto c : colliderComponents)
+	return PAIR_TESTS[static_cast<int>(a->GetShape())][static_cast<int>(b->GetShape())](a, &positionA, b, &positionB);
+}
+
+SpatialGrid& Physics::GetColliderGrid(Game* game)
+{
+	return game->GetColliderGrid();
+}
+
+void Physics::GetOverlappingColliders(Game* game, Collider* collider, std::vector<ColliderComponent*>& outHits)
+{
+	outHits.clear();
+	ForEachOverlappingCollider(game, collider, collider->GetComponent()->GetPosition(), collider->GetComponent()->GetFilter(),
+							   [&outHits](ColliderComponent* c) { PushBackTracked(outHits, c); });
+}
+
+void Physics::ConeCast(Game *game, Vector2 origin, Vector2 direction, float angle, float radius, CollisionFilter filter, std::vector<ColliderComponent*>& outHits)
+{
+	outHits.clear();
+	FixedPolygon coneTriangle = GetConePolygon(origin, direction, angle, radius);
+
+	// The cone never reaches further than its radius, so that box bounds the query
+	Vector2 min(origin.x - radius, origin.y - radius);
+	Vector2 max(origin.x + radius, origin.y + radius);
+	game->GetColliderGrid().Query(min, max, [&](ColliderComponent* c)
+	{
+		if (!c->IsEnabled()) return;
+		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) return;
+		if (!IsColliderWithinDistance(origin, c, radius)) return;
+
+		if (OverlapTriangleCollider(coneTriangle, c->GetCollider())) PushBackTracked(outHits, c);
+	});
+
+	if (game->IsDebugging()) DebugDrawPolygon(game, coneTriangle, 0.5f);
+}
+
+void Physics::CheckCollisionAt(Game* game, Collider* collider, Vector2 newPosition, CollisionFilter filter, std::vector<ColliderComponent*>& outHits)
+{
+	outHits.clear();
+	ForEachOverlappingCollider(game, collider, newPosition, filter,
+							   [&outHits](ColliderComponent* c) { PushBackTracked(outHits, c); });
+}
+
+bool Physics::Raycast(Game* game, Vector2 origin, Vector2 end, CollisionFilter filter, RaycastHit& outHit, const ColliderComponent* ignore)
+{
+	Vector2 delta = end - origin;
+	float closest = 1.0f;
+	bool hit = false;
+
+	float time;
+	Vector2 normal;
+	const TileCollisionMap& tileMap = game->GetTileCollisionMap();
+	if (GameConstants::STATIC_COLLISION_MODE == StaticCollisionMode::TileMap &&
+		CollisionFilter::ShouldCollide(filter, tileMap.GetFilter()) &&
+		RaycastTileMap(tileMap, origin, delta, time, normal))
+	{
+		closest = time;
+		outHit.normal = normal;
+		outHit.collider = nullptr;
+		hit = true;
+	}
+
+	// Nothing past the first wall can be hit, so only query up to it
+	Vector2 clippedEnd = origin + delta * closest;
+	Vector2 min(Math::Min(origin.x, clippedEnd.x), Math::Min(origin.y, clippedEnd.y));
+	Vector2 max(Math::Max(origin.x, clippedEnd.x), Math::Max(origin.y, clippedEnd.y));
+
+	GetColliderGrid(game).Query(min, max, [&](ColliderComponent* other)
+	{
+		if (other == ignore || !other->IsEnabled() || !other->GetCollider()) return;
+		if (!CollisionFilter::ShouldCollide(filter, other->GetFilter())) return;
+
+		const Collider* collider = other->GetCollider();
+		Vector2 position = other->GetPosition();
+
+		bool colliderHit;
+		if (collider->GetShape() == ColliderShape::Circle)
+		{
+			// A circle swept against a single point is the ray against that circle
+			float radius = static_cast<const CircleCollider*>(collider)->GetRadius();
+			colliderHit = SweepCircleAABB(origin, radius, delta, position, position, time, normal);
+		}
+		else
+		{
+			Vector2 bMin, bMax;
+			collider->GetBoundsAt(position, bMin, bMax);
+			colliderHit = SweepAABB(origin, origin, delta, bMin, bMax, time, normal);
+		}
+
+		if (colliderHit && time < closest)
+		{
+			closest = time;
+			outHit.normal = normal;
+			outHit.collider = other;
+			hit = true;
+		}
+	});
+
+	if (!hit) return false;
+
+	outHit.point = origin + delta * closest;
+	outHit.distance = delta.Length() * closest;
+	return true;
+}
+
+bool Physics::HasLineOfSight(Game* game, Vector2 a, Vector2 b)
+{
+	if (GameConstants::STATIC_COLLISION_MODE == StaticCollisionMode::TileMap)
+	{
+		float time;
+		Vector2 normal;
+		return !RaycastTileMap(game->GetTileCollisionMap(), a, b - a, time, normal);
+	}
+
+	// Only the merged wall colliders accept this filter
+	CollisionFilter filter;
+	filter.belongsTo = CollisionFilter::GroupMask({CollisionGroup::Environment});
+	filter.collidesWith = CollisionFilter::GroupMask({CollisionGroup::Environment});
+
+	RaycastHit hit;
+	return !Raycast(game, a, b, filter, hit);
+}
+
+bool Physics::RaycastTileMap(const TileCollisionMap& tileMap, Vector2 origin, Vector2 delta, float& outTime, Vector2& outNormal)
+{
+	if (tileMap.IsEmpty()) return false;
+
+	int x = tileMap.ToTile(origin.x);
+	int y = tileMap.ToTile(origin.y);
+	if (tileMap.IsSolid(x, y))
+	{
+		outTime = 0.0f;
+		outNormal = Vector2::Zero;
+		return true;
+	}
+
+	// Step from tile boundary to tile boundary, always crossing the closest one next
+	float tileSize = tileMap.GetTileSize();
+	int stepX = delta.x > 0.0f ? 1 : -1;
+	int stepY = delta.y > 0.0f ? 1 : -1;
+
+	float stepTimeX = delta.x != 0.0f ? tileSize / Math::Abs(delta.x) : Math::Infinity;
+	float stepTimeY = delta.y != 0.0f ? tileSize / Math::Abs(delta.y) : Math::Infinity;
+
+	float nextTimeX = delta.x != 0.0f ? ((x + (stepX > 0 ? 1 : 0)) * tileSize - origin.x) / delta.x : Math::Infinity;
+	float nextTimeY = delta.y != 0.0f ? ((y + (stepY > 0 ? 1 : 0)) * tileSize - origin.y) / delta.y : Math::Infinity;
+
+	int steps = std::abs(tileMap.ToTile(origin.x + delta.x) - x) + std::abs(tileMap.ToTile(origin.y + delta.y) - y);
+	for (int i = 0; i < steps; ++i)
+	{
+		float time;
+		if (nextTimeX < nextTimeY)
+		{
+			x += stepX;
+			time = nextTimeX;
+			nextTimeX += stepTimeX;
+			outNormal = Vector2(static_cast<float>(-stepX), 0.0f);
+		}
+		else
+		{
+			y += stepY;
+			time = nextTimeY;
+			nextTimeY += stepTimeY;
+			outNormal = Vector2(0.0f, static_cast<float>(-stepY));
+		}
+
+		if (time > 1.0f) return false;
+		if (tileMap.IsSolid(x, y))
+		{
+			outTime = time;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Physics::SweepStatic(Game* game, const ColliderComponent* component, const Vector2& displacement, float& outTime, Vector2& outNormal)
+{
+	const Collider* collider = component->GetCollider();
+	if (!collider) return false;
+
+	ColliderShape shape = collider->GetShape();
+	if (shape != ColliderShape::AABB && shape != ColliderShape::Circle) return false;
+
+	Vector2 position = component->GetPosition();
+	Vector2 min, max;
+	collider->GetBoundsAt(position, min, max);
+
+	Vector2 sweptMin(Math::Min(min.x, min.x + displacement.x), Math::Min(min.y, min.y + displacement.y));
+	Vector2 sweptMax(Math::Max(max.x, max.x + displacement.x), Math::Max(max.y, max.y + displacement.y));
+
+	bool hit = false;
+	outTime = 1.0f;
+
+	auto sweepBox = [&](const Vector2& bMin, const Vector2& bMax)
 	{
-		if (!c->IsEnabled()) continue;
-		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) continue;
-		if (!IsColliderWithinDistance(origin, c, radius)) continue;
+		float time;
+		Vector2 normal;
+		bool boxHit = shape == ColliderShape::AABB
+			? SweepAABB(min, max, displacement, bMin, bMax, time, normal)
+			: SweepCircleAABB(position, static_cast<const CircleCollider*>(collider)->GetRadius(), displacement, bMin, bMax, time, normal);
 
-		if (OverlapTriangleCollider(coneTriangle, c->GetCollider())) hitColliders.push_back(c);
+		if (boxHit && time < outTime)
+		{
+			outTime = time;
+			outNormal = normal;
+			hit = true;
+		}
+	};
+
+	CollisionFilter filter = component->GetFilter();
+	const TileCollisionMap& tileMap = game->GetTileCollisionMap();
+	if (GameConstants::STATIC_COLLISION_MODE == StaticCollisionMode::TileMap &&
+		CollisionFilter::ShouldCollide(filter, tileMap.GetFilter()))
+	{
+		tileMap.ForEachSolidTile(sweptMin, sweptMax, [&](int x, int y)
+		{
+			sweepBox(tileMap.GetTileMin(x, y), tileMap.GetTileMax(x, y));
+		});
 	}
 
-	if (game->IsDebugging()) DebugDrawPolygon(game, coneTriangle, 0.5f, 15);
-	return hitColliders;
+	GetColliderGrid(game).Query(sweptMin, sweptMax, [&](ColliderComponent* other)
+	{
+		if (other == component || !other->IsStatic() || !other->IsEnabled()) return;
+		if (!other->GetCollider() || other->GetCollider()->GetShape() != ColliderShape::AABB) return;
+		if (!CollisionFilter::ShouldCollide(filter, other->GetFilter())) return;
+
+		Vector2 bMin, bMax;
+		other->GetCollider()->GetBoundsAt(other->GetPosition(), bMin, bMax);
+		sweepBox(bMin, bMax);
+	});
+
+	return hit;
 }
 
-std::vector<ColliderComponent*> Physics::CheckCollisionAt(Game* game, Collider* collider, Vector2 newPosition, CollisionFilter filter)
+bool Physics::SweepAABB(const Vector2& min, const Vector2& max, const Vector2& displacement,
+						const Vector2& bMin, const Vector2& bMax, float& outTime, Vector2& outNormal)
 {
-	std::vector<ColliderComponent*> hitColliders;
-	auto colliderComponents = game->GetColliders();
-	for (auto c : colliderComponents)
+	float entry = Math::NegInfinity;
+	float exit = Math::Infinity;
+	Vector2 normal = Vector2::Zero;
+
+	// Slab test of the moving box against b, one axis at a time
+	auto sweepAxis = [&](float aMin, float aMax, float delta, float otherMin, float otherMax, const Vector2& axis)
 	{
-		if (!c->IsEnabled()) continue;
-		if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) continue;
-		if (collider->CheckCollision(c->GetCollider()))
+		// Not moving on this axis, so it has to overlap for the whole step
+		if (delta == 0.0f) return aMin < otherMax && aMax > otherMin;
+
+		float axisEntry = (delta > 0.0f ? otherMin - aMax : otherMax - aMin) / delta;
+		float axisExit = (delta > 0.0f ? otherMax - aMin : otherMin - aMax) / delta;
+
+		if (axisEntry > entry)
 		{
-			hitColliders.push_back(c);
+			entry = axisEntry;
+			normal = delta > 0.0f ? axis * -1.0f : axis;
 		}
+		exit = Math::Min(exit, axisExit);
+		return true;
+	};
+
+	if (!sweepAxis(min.x, max.x, displacement.x, bMin.x, bMax.x, Vector2::UnitX)) return false;
+	if (!sweepAxis(min.y, max.y, displacement.y, bMin.y, bMax.y, Vector2::UnitY)) return false;
+
+	// Missed, grazing, already overlapping, or too far to reach this step
+	if (entry >= exit || entry < 0.0f || entry > 1.0f) return false;
+
+	outTime = entry;
+	outNormal = normal;
+	return true;
+}
+
+bool Physics::SweepCircleAABB(const Vector2& center, float radius, const Vector2& displacement,
+							  const Vector2& bMin, const Vector2& bMax, float& outTime, Vector2& outNormal)
+{
+	// Sweep the center against the box grown by the radius, which is exact away from the corners
+	Vector2 extent(radius, radius);
+	float time;
+	Vector2 normal;
+	if (!SweepAABB(center, center, displacement, bMin - extent, bMax + extent, time, normal)) return false;
+
+	Vector2 hitPoint = center + displacement * time;
+	bool insideX = hitPoint.x >= bMin.x && hitPoint.x <= bMax.x;
+	bool insideY = hitPoint.y >= bMin.y && hitPoint.y <= bMax.y;
+	if (insideX || insideY)
+	{
+		outTime = time;
+		outNormal = normal;
+		return true;
 	}
 
-	return hitColliders;
+	// In a corner region the grown box is rounded, so intersect the ray with the corner circle
+	Vector2 corner(hitPoint.x < bMin.x ? bMin.x : bMax.x, hitPoint.y < bMin.y ? bMin.y : bMax.y);
+	Vector2 toCenter = center - corner;
+
+	float a = Vector2::Dot(displacement, displacement);
+	float b = Vector2::Dot(toCenter, displacement);
+	float c = Vector2::Dot(toCenter, toCenter) - radius * radius;
+	float discriminant = b * b - a * c;
+	if (c < 0.0f || discriminant < 0.0f) return false;
+
+	time = (-b - Math::Sqrt(discriminant)) / a;
+	if (time < 0.0f || time > 1.0f) return false;
+
+	outTime = time;
+	outNormal = center + displacement * time - corner;
+	outNormal.Normalize();
+	return true;
 }
 
 bool Physics::OverlapCircleAABB(Vector2 center, float radius, const AABBCollider *aabb, Vector2* posAABB)
@@ -133,31 +442,83 @@ bool Physics::OverlapCircleAABB(Vector2 center, float radius, const AABBCollider
 	return distSq <= radiusSq;
 }
 
-bool Physics::OverlapTriangleCollider(const std::vector<Vector2>& triangle, const Collider* collider)
+bool Physics::OverlapTriangleCollider(const FixedPolygon& triangle, const Collider* collider)
 {
-	if (auto aabb = dynamic_cast<const AABBCollider*>(collider))
-		return OverlapTriangleAABB(triangle, aabb);
-	else if (auto circle = dynamic_cast<const CircleCollider*>(collider))
+	switch (collider->GetShape())
+	{
+	case ColliderShape::AABB:
+		return OverlapTriangleAABB(triangle, static_cast<const AABBCollider*>(collider));
+	case ColliderShape::Circle:
+	{
+		auto circle = static_cast<const CircleCollider*>(collider);
+		return OverlapCirclePolygon(circle->GetComponent()->GetPosition(), circle->GetRadius(), triangle);
+	}
+	case ColliderShape::Polygon:
+	{
+		auto poly = static_cast<const PolygonCollider*>(collider);
+		return OverlapPolygons(triangle, FixedPolygon::FromVertices(poly->GetVertices(), poly->GetComponent()->GetPosition()));
+	}
+	default:
 		return false;
-	return false;
+	}
 }
 
-bool Physics::OverlapTriangleAABB(const std::vector<Vector2>& triangle, const AABBCollider *aabb)
+bool Physics::OverlapCirclePolygon(Vector2 center, float radius, const FixedPolygon& polygon)
 {
-	Vector2 aabbMin = aabb->GetMin();
-	Vector2 aabbMax = aabb->GetMax();
-	std::vector<Vector2> box = {
-		aabbMin,
-		Vector2(aabbMax.x, aabbMin.y),
-		aabbMax,
-		Vector2(aabbMin.x, aabbMax.y)
-	};
-	bool overlap = OverlapPolygons(triangle, box);
+	if (polygon.count == 0) return false;
+
+	// SAT: the polygon's edge normals plus the axis from the center to the closest vertex
+	int count = polygon.count;
+	Vector2 closestVertex = polygon.GetVertex(0);
+	float closestDistSq = (closestVertex - center).LengthSq();
+
+	for (int i = 0; i < count; ++i)
+	{
+		Vector2 vertex = polygon.GetVertex(i);
+		Vector2 edge = polygon.GetVertex((i + 1) % count) - vertex;
+		Vector2 axis(-edge.y, edge.x); // Perpendicular
+		axis.Normalize();
+		if (!CircleOverlapsPolygonOnAxis(center, radius, polygon, axis)) return false;
+
+		float distSq = (vertex - center).LengthSq();
+		if (distSq < closestDistSq)
+		{
+			closestDistSq = distSq;
+			closestVertex = vertex;
+		}
+	}
+
+	// Center sits on a vertex
+	if (Math::NearlyZero(closestDistSq)) return true;
+
+	Vector2 axis = closestVertex - center;
+	axis.Normalize();
+	return CircleOverlapsPolygonOnAxis(center, radius, polygon, axis);
+}
+
+bool Physics::CircleOverlapsPolygonOnAxis(Vector2 center, float radius, const FixedPolygon& polygon, const Vector2& axis)
+{
+	float minPoly, maxPoly;
+	ProjectPolygonOntoAxis(polygon, axis, minPoly, maxPoly);
 
-	return overlap;
+	float projectedCenter = Vector2::Dot(center, axis);
+	return !(maxPoly < projectedCenter - radius || projectedCenter + radius < minPoly);
+}
+
+bool Physics::OverlapTriangleAABB(const FixedPolygon& triangle, const AABBCollider *aabb)
+{
+	return OverlapPolygons(triangle, FixedPolygon::FromBox(aabb->GetMin(), aabb->GetMax()));
 }
 
 std::vector<Vector2> Physics::GetConeVertices(Vector2 origin, Vector2 direction, float angle, float length)
+{
+	FixedPolygon cone = GetConePolygon(origin, direction, angle, length);
+
+	TrackAllocation();
+	return {cone.GetVertex(0), cone.GetVertex(1), cone.GetVertex(2)};
+}
+
+FixedPolygon Physics::GetConePolygon(Vector2 origin, Vector2 direction, float angle, float length)
 {
 	direction.Normalize();
 	float halfAngle = angle / 2.0f;
@@ -168,48 +529,53 @@ std::vector<Vector2> Physics::GetConeVertices(Vector2 origin, Vector2 direction,
 	Vector2 rightDir = rotationRight * direction;
 	Vector2 leftDir = rotationLeft * direction;
 
-	Vector2 v0 = origin;
-	Vector2 v1 = origin + rightDir * length;
-	Vector2 v2 = origin + leftDir * length;
-	
-	return {v0, v1, v2};
+	FixedPolygon cone;
+	cone.Add(origin);
+	cone.Add(origin + rightDir * length);
+	cone.Add(origin + leftDir * length);
+	return cone;
 }
 
-bool Physics::OverlapPolygons(const std::vector<Vector2> &polyA, const std::vector<Vector2> &polyB)
+bool Physics::OverlapPolygons(const FixedPolygon& polyA, const FixedPolygon& polyB)
 {
-	// Using Separating Axis Theorem (SAT)
-	auto edgesA = GetPolygonEdges(polyA);
-	auto edgesB = GetPolygonEdges(polyB);
+	// An empty polygon has no area to overlap, and its slots were never written
+	if (polyA.count == 0 || polyB.count == 0) return false;
 
-	for (const auto &edge : edgesA)
+	// Using Separating Axis Theorem (SAT). Axes don't need normalizing to find a gap
+	for (int i = 0; i < polyA.count; ++i)
 	{
-		Vector2 axis(-edge.y, edge.x); // Perpendicular
-		axis.Normalize();
+		int next = (i + 1) % polyA.count;
+		Vector2 axis(polyA.y[i] - polyA.y[next], polyA.x[next] - polyA.x[i]); // Perpendicular
 		if (!PolygonsOverlapOnAxis(polyA, polyB, axis)) return false; // Found separating axis
 	}
-	
-	for (const auto &edge : edgesB)
+
+	for (int i = 0; i < polyB.count; ++i)
 	{
-		Vector2 axis(-edge.y, edge.x); // Perpendicular
-		axis.Normalize();
+		int next = (i + 1) % polyB.count;
+		Vector2 axis(polyB.y[i] - polyB.y[next], polyB.x[next] - polyB.x[i]); // Perpendicular
 		if (!PolygonsOverlapOnAxis(polyA, polyB, axis)) return false; // Found separating axis
 	}
-	
+
 	return true; // No separating axis found, polygons overlap
 }
 
 bool Physics::IsColliderWithinDistance(Vector2 origin, const ColliderComponent* collider, float radius)
 {
     const Collider* baseCollider = collider->GetCollider();
-    if (const AABBCollider* aabb = dynamic_cast<const AABBCollider*>(baseCollider)) 
-		return GetPointAABBDistanceSq(origin, aabb) <= (radius * radius);
-    else if (const CircleCollider* circle = dynamic_cast<const CircleCollider*>(baseCollider)) {
+    switch (baseCollider->GetShape())
+    {
+    case ColliderShape::AABB:
+        return GetPointAABBDistanceSq(origin, static_cast<const AABBCollider*>(baseCollider)) <= (radius * radius);
+    case ColliderShape::Circle:
+    {
         Vector2 center = collider->GetPosition();
         float dx = origin.x - center.x;
         float dy = origin.y - center.y;
         return (dx * dx + dy * dy) <= (radius * radius);
     }
-    return false;
+    default:
+        return false;
+    }
 }
 
 float Physics::GetPointAABBDistanceSq(Vector2 point, const AABBCollider* aabb, Vector2* posAABB)
@@ -223,51 +589,55 @@ float Physics::GetPointAABBDistanceSq(Vector2 point, const AABBCollider* aabb, V
 	return dx * dx + dy * dy;
 }
 	
-std::vector<Vector2> Physics::GetPolygonEdges(const std::vector<Vector2> &poly)
+void Physics::ProjectPolygonOntoAxis(const FixedPolygon& poly, const Vector2& axis, float& min, float& max)
 {
-	std::vector<Vector2> edges;
-	size_t count = poly.size();
-	for (size_t i = 0; i < count; ++i)
+	// Empty interval, so nothing overlaps it
+	if (poly.count == 0)
+	{
+		min = Math::Infinity;
+		max = Math::NegInfinity;
+		return;
+	}
+
+	// Padding slots repeat the last vertex, so a fixed trip count is safe and vectorizes
+	min = max = poly.x[0] * axis.x + poly.y[0] * axis.y;
+	for (int i = 1; i < FixedPolygon::MAX_VERTICES; ++i)
 	{
-		Vector2 edge = poly[(i + 1) % count] - poly[i];
-		edges.push_back(edge);
+		float projection = poly.x[i] * axis.x + poly.y[i] * axis.y;
+		min = Math::Min(min, projection);
+		max = Math::Max(max, projection);
 	}
-	return edges;
 }
 
-void Physics::ProjectPolygonOntoAxis(const std::vector<Vector2> &poly, const Vector2 &axis, float &min, float &max)
+bool Physics::PolygonsOverlapOnAxis(const FixedPolygon& polyA, const FixedPolygon& polyB, const Vector2& axis)
 {
-	min = max = Vector2::Dot(poly[0], axis);
-	for (const auto &vertex : poly)
+	if (polyA.count == 0 || polyB.count == 0) return false;
+
+	// Both shapes are projected in the same pass
+	float minA = polyA.x[0] * axis.x + polyA.y[0] * axis.y;
+	float minB = polyB.x[0] * axis.x + polyB.y[0] * axis.y;
+	float maxA = minA;
+	float maxB = minB;
+	for (int i = 1; i < FixedPolygon::MAX_VERTICES; ++i)
 	{
-		float projection = Vector2::Dot(vertex, axis);
-		if (projection < min) min = projection;
-		if (projection > max) max = projection;
+		float projectionA = polyA.x[i] * axis.x + polyA.y[i] * axis.y;
+		float projectionB = polyB.x[i] * axis.x + polyB.y[i] * axis.y;
+		minA = Math::Min(minA, projectionA);
+		maxA = Math::Max(maxA, projectionA);
+		minB = Math::Min(minB, projectionB);
+		maxB = Math::Max(maxB, projectionB);
 	}
+
+	return !(maxA < minB || maxB < minA);
 }
 
-bool Physics::PolygonsOverlapOnAxis(const std::vector<Vector2> &polyA, const std::vector<Vector2> &polyB, const Vector2 &axis)
+void Physics::DebugDrawPolygon(Game* game, const std::vector<Vector2>& polygon, float lifetime)
 {
-	float minA, maxA, minB, maxB;
-	ProjectPolygonOntoAxis(polyA, axis, minA, maxA);
-	ProjectPolygonOntoAxis(polyB, axis, minB, maxB);
-	return !(maxA < minB || maxB < minA);
+	DebugDrawPolygon(game, FixedPolygon::FromVertices(polygon), lifetime);
 }
 
-void Physics::DebugDrawPolygon(Game* game, const std::vector<Vector2>& polygon, float lifetime, int particlesPerEdge)
+void Physics::DebugDrawPolygon(Game* game, const FixedPolygon& polygon, float lifetime)
 {
-	auto particleSystem = game->GetDebugActor()->GetParticleSystemComponent();
-    if (!particleSystem || polygon.size() < 2) return;
-    for (size_t i = 0; i < polygon.size(); ++i)
-    {
-        const Vector2& start = polygon[i];
-        const Vector2& end = polygon[(i + 1) % polygon.size()];
-        Vector2 edge = end - start;
-        for (int j = 0; j <= particlesPerEdge; ++j)
-        {
-            float t = static_cast<float>(j) / static_cast<float>(particlesPerEdge);
-            Vector2 pos = start + edge * t;
-            particleSystem->EmitParticle(lifetime, 0.0f, pos - particleSystem->GetOwner()->GetPosition());
-        }
-    }
+	auto debugActor = game->GetDebugActor();
+	if (debugActor) debugActor->AddPolygon(polygon, lifetime);
 }
\ No newline at end of file
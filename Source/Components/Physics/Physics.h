@@ -2,10 +2,21 @@
 #include "../../Math.h"
 #include "CollisionFilter.h"
 #include "Collider.h"
+#include "FixedPolygon.h"
 #include <vector>
 
 class ColliderComponent;
 class Game;
+class SpatialGrid;
+class TileCollisionMap;
+
+struct RaycastHit
+{
+	Vector2 point;
+	Vector2 normal;
+	float distance;
+	ColliderComponent* collider; // nullptr when a wall tile was hit
+};
 
 class Physics
 {
@@ -17,25 +28,91 @@ public:
 	static bool CheckCircleCircle(const CircleCollider *a, const CircleCollider *b, Vector2 *positionA = nullptr, Vector2 *positionB = nullptr);
 	static bool CheckPolygonPolygon(const PolygonCollider *a, const PolygonCollider *b, Vector2 *positionA = nullptr, Vector2 *positionB = nullptr);
 	static bool CheckPolygonAABB(const PolygonCollider* poly, const AABBCollider* aabb, Vector2* positionPoly = nullptr, Vector2* positionAABB = nullptr);
+	static bool CheckCirclePolygon(const CircleCollider* circle, const PolygonCollider* poly, Vector2* positionCircle = nullptr, Vector2* positionPoly = nullptr);
+
+	// Narrowphase for any pair of shapes, dispatched through a table on the shape tags
+	static bool CheckPair(const Collider* a, Vector2 positionA, const Collider* b, Vector2 positionB);
+
+	// Queries write their hits into a buffer owned by the caller (cleared first).
+	// Keep the buffer around between calls so steady-state queries don't allocate
+	static void GetOverlappingColliders(Game* game, Collider* collider, std::vector<ColliderComponent*>& outHits);
+	static void ConeCast(Game* game, Vector2 origin, Vector2 direction, float angle, float radius, CollisionFilter filter, std::vector<ColliderComponent*>& outHits);
+	static void CheckCollisionAt(Game* game, Collider* collider, Vector2 newPosition, CollisionFilter filter, std::vector<ColliderComponent*>& outHits);
+
+	// Calls func for every enabled collider passing the filter that overlaps collider placed at position.
+	// func must not run other queries
+	template <typename Func>
+	static void ForEachOverlappingCollider(Game* game, const Collider* collider, Vector2 position, CollisionFilter filter, Func&& func)
+	{
+		Vector2 min, max;
+		collider->GetBoundsAt(position, min, max);
+		GetColliderGrid(game).Query(min, max, [&](ColliderComponent* c)
+		{
+			if (!c->IsEnabled()) return;
+			if (!CollisionFilter::ShouldCollide(filter, c->GetFilter())) return;
+
+			if (collider->CheckCollisionAt(&position, c->GetCollider())) func(c);
+		});
+	}
 
-	static std::vector<ColliderComponent*> GetOverlappingColliders(Game* game, Collider* collider);
-	static std::vector<ColliderComponent*> ConeCast(Game* game, Vector2 origin, Vector2 direction, float angle, float radius, CollisionFilter filter);
+	// Casts a segment from origin to end. Walls are found by walking the tile grid (DDA), everything
+	// else through the broadphase. Circles and AABBs are exact, polygons are tested against their bounds
+	static bool Raycast(Game* game, Vector2 origin, Vector2 end, CollisionFilter filter, RaycastHit& outHit,
+						const ColliderComponent* ignore = nullptr);
+	// True when no wall lies between a and b. Characters never block the line
+	static bool HasLineOfSight(Game* game, Vector2 a, Vector2 b);
 
-	static std::vector<ColliderComponent*> CheckCollisionAt(Game* game, Collider* collider, Vector2 newPosition, CollisionFilter filter);
+	// Continuous collision against the static world (wall tiles and static AABB colliders).
+	// Finds the first hit of the collider moving by displacement, as a fraction of it in outTime.
+	// Only AABB and circle colliders are swept, and contacts that already overlap at the start are left to the discrete solve
+	static bool SweepStatic(Game* game, const ColliderComponent* component, const Vector2& displacement, float& outTime, Vector2& outNormal);
+	static bool SweepAABB(const Vector2& min, const Vector2& max, const Vector2& displacement,
+						  const Vector2& bMin, const Vector2& bMax, float& outTime, Vector2& outNormal);
+	static bool SweepCircleAABB(const Vector2& center, float radius, const Vector2& displacement,
+								const Vector2& bMin, const Vector2& bMax, float& outTime, Vector2& outNormal);
+
+	// Allocation tracking for the physics module, reset at the start of every frame
+	static void ResetFrameStats() { sFrameAllocations = 0; sRigidBodies = 0; sAwakeRigidBodies = 0; }
+	static int GetFrameAllocations() { return sFrameAllocations; }
+	static void TrackAllocation(int count = 1) { sFrameAllocations += count; }
+
+	// Rigid bodies updated this frame and how many of them were awake
+	static void TrackRigidBody(bool awake) { ++sRigidBodies; if (awake) ++sAwakeRigidBodies; }
+	static int GetRigidBodies() { return sRigidBodies; }
+	static int GetAwakeRigidBodies() { return sAwakeRigidBodies; }
+
+	template <typename T>
+	static void PushBackTracked(std::vector<T>& vector, const T& value)
+	{
+		if (vector.size() == vector.capacity()) TrackAllocation();
+		vector.push_back(value);
+	}
 	
 	static bool OverlapCircleAABB(Vector2 center, float radius, const AABBCollider* aabb, Vector2* posAABB = nullptr);
-	static bool OverlapTriangleCollider(const std::vector<Vector2>& triangle, const Collider* collider);
-	static bool OverlapTriangleAABB(const std::vector<Vector2>& triangle, const AABBCollider* aabb);
-	static bool OverlapPolygons(const std::vector<Vector2>& polyA, const std::vector<Vector2>& polyB);
+	// SAT tests work on stack polygons and never allocate
+	static bool OverlapTriangleCollider(const FixedPolygon& triangle, const Collider* collider);
+	static bool OverlapTriangleAABB(const FixedPolygon& triangle, const AABBCollider* aabb);
+	static bool OverlapPolygons(const FixedPolygon& polyA, const FixedPolygon& polyB);
+	static bool OverlapCirclePolygon(Vector2 center, float radius, const FixedPolygon& polygon);
 	
 	static std::vector<Vector2> GetConeVertices(Vector2 origin, Vector2 direction, float angle, float length);
+	static FixedPolygon GetConePolygon(Vector2 origin, Vector2 direction, float angle, float length);
 	static float GetPointAABBDistanceSq(Vector2 point, const AABBCollider* aabb, Vector2* posAABB = nullptr);
 	static bool IsColliderWithinDistance(Vector2 origin, const ColliderComponent* collider, float radius);
-	static void DebugDrawPolygon(class Game* game, const std::vector<Vector2>& polygon, float lifetime, int particlesPerEdge = 20);
+	// Outlines the polygon through the debug actor for lifetime seconds
+	static void DebugDrawPolygon(class Game* game, const std::vector<Vector2>& polygon, float lifetime);
+	static void DebugDrawPolygon(class Game* game, const FixedPolygon& polygon, float lifetime);
 	static bool ShouldCollide(unsigned int belongsToA, unsigned int collidesWithA, unsigned int belongsToB, unsigned int collidesWithB);
 
 private:
-	static std::vector<Vector2> GetPolygonEdges(const std::vector<Vector2>& poly);
-	static void ProjectPolygonOntoAxis(const std::vector<Vector2>& poly, const Vector2& axis, float& min, float& max);
-	static bool PolygonsOverlapOnAxis(const std::vector<Vector2>& polyA, const std::vector<Vector2>& polyB, const Vector2& axis);
+	static SpatialGrid& GetColliderGrid(Game* game);
+	static bool RaycastTileMap(const TileCollisionMap& tileMap, Vector2 origin, Vector2 delta, float& outTime, Vector2& outNormal);
+
+	inline static int sFrameAllocations = 0;
+	inline static int sRigidBodies = 0;
+	inline static int sAwakeRigidBodies = 0;
+
+	static void ProjectPolygonOntoAxis(const FixedPolygon& poly, const Vector2& axis, float& min, float& max);
+	static bool PolygonsOverlapOnAxis(const FixedPolygon& polyA, const FixedPolygon& polyB, const Vector2& axis);
+	static bool CircleOverlapsPolygonOnAxis(Vector2 center, float radius, const FixedPolygon& polygon, const Vector2& axis);
 };
\ No newline at end of file
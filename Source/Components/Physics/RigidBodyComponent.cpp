@@ -8,6 +8,7 @@
 #include "../../GameConstants.h"
 #include "RigidBodyComponent.h"
 #include "ColliderComponent.h"
+#include "Physics.h"
 
 RigidBodyComponent::RigidBodyComponent(class Actor* owner, float mass, float friction, bool applyGravity, int updateOrder)
         :Component(owner, updateOrder)
@@ -15,17 +16,38 @@ RigidBodyComponent::RigidBodyComponent(class Actor* owner, float mass, float fri
         ,mFrictionCoefficient(friction)
         ,mVelocity(Vector2::Zero)
         ,mAcceleration(Vector2::Zero)
+        ,mIsAwake(true)
+        ,mCanSleep(true)
+        ,mSleepTime(GameConstants::RIGID_BODY_SLEEP_TIME)
+        ,mStillTimer(0.0f)
 {
 
 }
 
 void RigidBodyComponent::ApplyForce(const Vector2 &force)
 {
+    if (force.x != 0.0f || force.y != 0.0f) WakeUp();
     mAcceleration += force * (1.f/mMass);
 }
 
+void RigidBodyComponent::WakeUp()
+{
+    mIsAwake = true;
+    mStillTimer = 0.0f;
+}
+
 void RigidBodyComponent::Update(float deltaTime)
 {
+    // Something moved the owner directly (teleport, pooled actor reuse)
+    if (!mIsAwake)
+    {
+        Vector2 position = mOwner->GetPosition();
+        if (position.x != mRestingPosition.x || position.y != mRestingPosition.y) WakeUp();
+    }
+
+    Physics::TrackRigidBody(mIsAwake);
+    if (!mIsAwake) return;
+
     // Apply friction
     if(Math::Abs(mVelocity.x) > 0.05f && mFrictionCoefficient != 0.0f)
     {
@@ -45,13 +67,62 @@ void RigidBodyComponent::Update(float deltaTime)
 
     auto collider = mOwner->GetComponent<ColliderComponent>();
 
-    Vector2 pos = mOwner->GetPosition();
-    pos.x += mVelocity.x * deltaTime;
-    pos.y += mVelocity.y * deltaTime;
-
-    mOwner->SetPosition(pos);
+    Vector2 displacement = mVelocity * deltaTime;
+    if (collider && collider->IsEnabled() && !collider->IsStatic())
+    {
+        MoveAndSweep(collider, displacement);
+    }
+    else
+    {
+        mOwner->SetPosition(mOwner->GetPosition() + displacement);
+    }
 
     if (collider) collider->DetectCollisions(this);
 
+    UpdateSleep(deltaTime);
     mAcceleration.Set(0.f, 0.f);
+}
+
+void RigidBodyComponent::MoveAndSweep(ColliderComponent* collider, Vector2 displacement)
+{
+    // Each hit removes the blocked axis, so a couple of iterations cover wall and corner slides
+    const int maxIterations = 3;
+    for (int i = 0; i < maxIterations; ++i)
+    {
+        if (Math::NearlyZero(displacement.LengthSq())) return;
+
+        float time;
+        Vector2 normal;
+        if (!Physics::SweepStatic(GetGame(), collider, displacement, time, normal))
+        {
+            mOwner->SetPosition(mOwner->GetPosition() + displacement);
+            return;
+        }
+
+        mOwner->SetPosition(mOwner->GetPosition() + displacement * time);
+
+        // Same as the discrete solve: drop the velocity going into the wall and slide with the rest
+        Vector2 remaining = displacement * (1.0f - time);
+        displacement = remaining - normal * Vector2::Dot(remaining, normal);
+        mVelocity -= normal * Vector2::Dot(mVelocity, normal);
+    }
+}
+
+void RigidBodyComponent::UpdateSleep(float deltaTime)
+{
+    bool still = Math::NearlyZero(mVelocity.x, 1.0f) && Math::NearlyZero(mVelocity.y, 1.0f) &&
+                 mAcceleration.x == 0.0f && mAcceleration.y == 0.0f;
+
+    if (!mCanSleep || !still)
+    {
+        mStillTimer = 0.0f;
+        return;
+    }
+
+    mStillTimer += deltaTime;
+    if (mStillTimer < mSleepTime) return;
+
+    mIsAwake = false;
+    mVelocity = Vector2::Zero;
+    mRestingPosition = mOwner->GetPosition();
 }
\ No newline at end of file
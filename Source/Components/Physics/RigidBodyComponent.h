@@ -18,6 +18,7 @@ public:
     const Vector2& GetVelocity() const { return mVelocity; }
     void SetVelocity(const Vector2& velocity)
     {
+        if (velocity.x != mVelocity.x || velocity.y != mVelocity.y) WakeUp();
         mVelocity = velocity;
     }
 
@@ -26,11 +27,28 @@ public:
 
     void ApplyForce(const Vector2 &force);
 
+    // Sleeping bodies skip integration and the collision solve until something wakes them
+    bool IsAwake() const { return mIsAwake; }
+    void WakeUp();
+    void SetCanSleep(bool canSleep) { mCanSleep = canSleep; if (!canSleep) WakeUp(); }
+    void SetSleepTime(float sleepTime) { mSleepTime = sleepTime; }
+
 private:
+    void UpdateSleep(float deltaTime);
+    // Moves the owner by displacement, stopping and sliding along the static world on the way
+    void MoveAndSweep(class ColliderComponent* collider, Vector2 displacement);
+
     // Physical properties
     float mFrictionCoefficient;
     float mMass;
 
     Vector2 mVelocity;
     Vector2 mAcceleration;
+
+    // Sleeping
+    bool mIsAwake;
+    bool mCanSleep;
+    float mSleepTime;
+    float mStillTimer;
+    Vector2 mRestingPosition;
 };
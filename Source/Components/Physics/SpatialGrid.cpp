@@ -0,0 +1,86 @@
+#include "SpatialGrid.h"
+#include "Physics.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize, float margin)
+	: mCellSize(cellSize)
+	, mMargin(margin)
+	, mQueryStamp(0)
+{
+}
+
+int SpatialGrid::ToCell(float coord) const
+{
+	return static_cast<int>(std::floor(coord / mCellSize));
+}
+
+long long SpatialGrid::GetCellKey(int x, int y)
+{
+	return (static_cast<long long>(x) << 32) | static_cast<unsigned int>(y);
+}
+
+void SpatialGrid::Update(ColliderComponent* collider, GridProxy& proxy, const Vector2& min, const Vector2& max)
+{
+	int minX = ToCell(min.x);
+	int minY = ToCell(min.y);
+	int maxX = ToCell(max.x);
+	int maxY = ToCell(max.y);
+
+	// Still inside the cells we were bucketed into, nothing to do
+	if (proxy.inserted && minX >= proxy.minX && minY >= proxy.minY && maxX <= proxy.maxX && maxY <= proxy.maxY)
+		return;
+
+	if (proxy.inserted) RemoveFromCells(collider, proxy);
+
+	proxy.minX = ToCell(min.x - mMargin);
+	proxy.minY = ToCell(min.y - mMargin);
+	proxy.maxX = ToCell(max.x + mMargin);
+	proxy.maxY = ToCell(max.y + mMargin);
+	proxy.inserted = true;
+
+	AddToCells(collider, proxy);
+}
+
+void SpatialGrid::Remove(ColliderComponent* collider, GridProxy& proxy)
+{
+	if (!proxy.inserted) return;
+
+	RemoveFromCells(collider, proxy);
+	proxy.inserted = false;
+}
+
+void SpatialGrid::AddToCells(ColliderComponent* collider, GridProxy& proxy)
+{
+	for (int y = proxy.minY; y <= proxy.maxY; ++y)
+	{
+		for (int x = proxy.minX; x <= proxy.maxX; ++x)
+		{
+			auto result = mCells.try_emplace(GetCellKey(x, y));
+			if (result.second) Physics::TrackAllocation();
+
+			Physics::PushBackTracked(result.first->second, CellEntry{collider, &proxy});
+		}
+	}
+}
+
+void SpatialGrid::RemoveFromCells(ColliderComponent* collider, const GridProxy& proxy)
+{
+	for (int y = proxy.minY; y <= proxy.maxY; ++y)
+	{
+		for (int x = proxy.minX; x <= proxy.maxX; ++x)
+		{
+			auto iter = mCells.find(GetCellKey(x, y));
+			if (iter == mCells.end()) continue;
+
+			auto& cell = iter->second;
+			auto found = std::find_if(cell.begin(), cell.end(), [collider](const CellEntry& entry)
+									  { return entry.collider == collider; });
+			if (found == cell.end()) continue;
+
+			// Swap to end of vector and pop off (avoid erase copies)
+			std::iter_swap(found, cell.end() - 1);
+			cell.pop_back();
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "../../Math.h"
+#include <unordered_map>
+#include <vector>
+
+class ColliderComponent;
+
+// Per-collider bookkeeping for the grid, stored on the ColliderComponent itself
+struct GridProxy
+{
+	int minX = 0;
+	int minY = 0;
+	int maxX = -1;
+	int maxY = -1;
+	bool inserted = false;
+	unsigned int queryStamp = 0;
+};
+
+// Uniform-grid broadphase. Colliders are bucketed by every cell their bounds touch,
+// so a query only has to look at the colliders sharing a cell with the query bounds.
+class SpatialGrid
+{
+public:
+	SpatialGrid(float cellSize, float margin);
+
+	// Inserts the collider or moves it to new cells. Bounds are fattened by the margin so
+	// small movements between syncs don't require re-bucketing
+	void Update(ColliderComponent* collider, GridProxy& proxy, const Vector2& min, const Vector2& max);
+	void Remove(ColliderComponent* collider, GridProxy& proxy);
+
+	// Calls func once for every collider whose cells overlap the given bounds.
+	// Iterates the cells in place, so func must not query or modify the grid itself
+	template <typename Func>
+	void Query(const Vector2& min, const Vector2& max, Func&& func)
+	{
+		// A collider spanning several cells is only reported the first time we see it
+		++mQueryStamp;
+
+		int minX = ToCell(min.x);
+		int minY = ToCell(min.y);
+		int maxX = ToCell(max.x);
+		int maxY = ToCell(max.y);
+
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				auto iter = mCells.find(GetCellKey(x, y));
+				if (iter == mCells.end()) continue;
+
+				for (const auto& entry : iter->second)
+				{
+					if (entry.proxy->queryStamp == mQueryStamp) continue;
+
+					entry.proxy->queryStamp = mQueryStamp;
+					func(entry.collider);
+				}
+			}
+		}
+	}
+
+private:
+	struct CellEntry
+	{
+		ColliderComponent* collider;
+		GridProxy* proxy;
+	};
+
+	int ToCell(float coord) const;
+	static long long GetCellKey(int x, int y);
+
+	void AddToCells(ColliderComponent* collider, GridProxy& proxy);
+	void RemoveFromCells(ColliderComponent* collider, const GridProxy& proxy);
+
+	float mCellSize;
+	float mMargin;
+	unsigned int mQueryStamp;
+
+	std::unordered_map<long long, std::vector<CellEntry>> mCells;
+};
@@ -0,0 +1,105 @@
+#include "TileCollisionMap.h"
+#include "../../Renderer/Renderer.h"
+#include <cmath>
+
+TileCollisionMap::TileCollisionMap(float tileSize)
+	: mTileSize(tileSize)
+	, mWidth(0)
+	, mHeight(0)
+{
+	// Walls are environment and block players, enemies and other environment colliders
+	mFilter.belongsTo = CollisionFilter::GroupMask({CollisionGroup::Environment});
+	mFilter.collidesWith = CollisionFilter::GroupMask({CollisionGroup::Player, CollisionGroup::Enemy, CollisionGroup::Environment});
+}
+
+void TileCollisionMap::Build(int** levelData, int width, int height)
+{
+	mWidth = width;
+	mHeight = height;
+	mSolid.assign(static_cast<size_t>(width) * height, 0);
+
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			mSolid[y * width + x] = IsSolidTileID(levelData[y][x]) ? 1 : 0;
+}
+
+void TileCollisionMap::Clear()
+{
+	mWidth = 0;
+	mHeight = 0;
+	mSolid.clear();
+}
+
+bool TileCollisionMap::IsSolidTileID(int tileID)
+{
+	return (tileID >= 4 && tileID <= 10 && tileID != 9) || (tileID >= 16 && tileID <= 27);
+}
+
+bool TileCollisionMap::IsSolid(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= mWidth || y >= mHeight) return false;
+	return mSolid[y * mWidth + x] != 0;
+}
+
+int TileCollisionMap::CountSolidTiles() const
+{
+	int count = 0;
+	for (auto solid : mSolid)
+		if (solid) ++count;
+	return count;
+}
+
+void TileCollisionMap::GetMergedRects(std::vector<TileRect>& outRects) const
+{
+	outRects.clear();
+	std::vector<unsigned char> merged(mSolid.size(), 0);
+
+	auto isFree = [&](int x, int y)
+	{
+		int index = y * mWidth + x;
+		return mSolid[index] && !merged[index];
+	};
+
+	for (int y = 0; y < mHeight; ++y)
+	{
+		for (int x = 0; x < mWidth; ++x)
+		{
+			if (!isFree(x, y)) continue;
+
+			int maxX = x;
+			while (maxX + 1 < mWidth && isFree(maxX + 1, y))
+				++maxX;
+
+			int maxY = y;
+			while (maxY + 1 < mHeight)
+			{
+				bool rowFree = true;
+				for (int i = x; i <= maxX && rowFree; ++i)
+					rowFree = isFree(i, maxY + 1);
+
+				if (!rowFree) break;
+				++maxY;
+			}
+
+			for (int j = y; j <= maxY; ++j)
+				for (int i = x; i <= maxX; ++i)
+					merged[j * mWidth + i] = 1;
+
+			outRects.push_back(TileRect{x, y, maxX, maxY});
+		}
+	}
+}
+
+int TileCollisionMap::ToTile(float coord) const
+{
+	return static_cast<int>(std::floor(coord / mTileSize));
+}
+
+void TileCollisionMap::DebugDraw(class Renderer* renderer, const Vector2& cameraPos) const
+{
+	Vector2 size(mTileSize, mTileSize);
+	for (int y = 0; y < mHeight; ++y)
+		for (int x = 0; x < mWidth; ++x)
+			if (mSolid[y * mWidth + x])
+				renderer->DrawRect(GetTileCenter(x, y), size, 0.0f, Color::Green, cameraPos, RendererMode::LINES);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "../../Math.h"
+#include "CollisionFilter.h"
+#include <vector>
+
+// Rectangle of solid tiles, in tile coordinates (inclusive)
+struct TileRect
+{
+	int minX;
+	int minY;
+	int maxX;
+	int maxY;
+};
+
+// Static collision layer baked from the level CSV. Walls are stored as a flat occupancy grid,
+// so testing against them is one lookup per touched tile instead of one collider per wall.
+class TileCollisionMap
+{
+public:
+	TileCollisionMap(float tileSize);
+
+	void Build(int** levelData, int width, int height);
+	void Clear();
+
+	// Wall tiles, the carpet (9) is walkable and handled by the LevelPortal
+	static bool IsSolidTileID(int tileID);
+
+	bool IsSolid(int x, int y) const;
+	bool IsEmpty() const { return mSolid.empty(); }
+	int CountSolidTiles() const;
+
+	// Covers every solid tile with as few rectangles as a greedy sweep finds:
+	// grow each run to the right, then downwards while the whole run stays solid
+	void GetMergedRects(std::vector<TileRect>& outRects) const;
+
+	int GetWidth() const { return mWidth; }
+	int GetHeight() const { return mHeight; }
+	float GetTileSize() const { return mTileSize; }
+
+	int ToTile(float coord) const;
+	Vector2 GetTileMin(int x, int y) const { return Vector2(x * mTileSize, y * mTileSize); }
+	Vector2 GetTileMax(int x, int y) const { return Vector2((x + 1) * mTileSize, (y + 1) * mTileSize); }
+	Vector2 GetTileCenter(int x, int y) const { return Vector2((x + 0.5f) * mTileSize, (y + 0.5f) * mTileSize); }
+
+	CollisionFilter GetFilter() const { return mFilter; }
+
+	void DebugDraw(class Renderer* renderer, const Vector2& cameraPos) const;
+
+	// Calls func(x, y) for every solid tile touched by the given bounds
+	template <typename Func>
+	void ForEachSolidTile(const Vector2& min, const Vector2& max, Func&& func) const
+	{
+		int minX = Math::Max(ToTile(min.x), 0);
+		int minY = Math::Max(ToTile(min.y), 0);
+		int maxX = Math::Min(ToTile(max.x), mWidth - 1);
+		int maxY = Math::Min(ToTile(max.y), mHeight - 1);
+
+		for (int y = minY; y <= maxY; ++y)
+			for (int x = minX; x <= maxX; ++x)
+				if (mSolid[y * mWidth + x]) func(x, y);
+	}
+
+private:
+	float mTileSize;
+	int mWidth;
+	int mHeight;
+
+	std::vector<unsigned char> mSolid;
+	CollisionFilter mFilter;
+};
@@ -61,8 +61,8 @@ void ClawAttack::Execute()
 	collisionActor->GetComponent<ColliderComponent>()->SetFilter(mCharacter->GetSkillFilter());
 
 	auto pos = mCharacter->GetPosition();
-	auto hitColliders = mAreaOfEffect->GetOverlappingCollidersAt(&pos);
-	for (auto collider : hitColliders)
+	mAreaOfEffect->GetOverlappingCollidersAt(&pos, mHitColliders);
+	for (auto collider : mHitColliders)
 	{
 		auto enemyActor = collider->GetOwner();
 		auto enemyCharacter = dynamic_cast<Character*>(enemyActor);
@@ -73,7 +73,7 @@ void ClawAttack::Execute()
 	{
 		auto vertices = ((PolygonCollider*)mAreaOfEffect)->GetVertices();
 		for (auto& v : vertices) v += pos;
-		Physics::DebugDrawPolygon(mCharacter->GetGame(), vertices, 0.5f, 15);
+		Physics::DebugDrawPolygon(mCharacter->GetGame(), vertices, 0.5f);
 	}
 
 }
@@ -22,6 +22,7 @@ private:
 	float mBackwardSpeed;
 
 	Collider* mAreaOfEffect;
+	std::vector<class ColliderComponent*> mHitColliders;
 
 	Vector2 mVelocity;
 
@@ -78,6 +78,7 @@ FurBallActor::FurBallActor(class Game* game)
 	mAnimatorComponent = new AnimatorComponent(this, "FurBallAnim", GameConstants::TILE_SIZE, GameConstants::TILE_SIZE);
 	CollisionFilter filter;
 	mColliderComponent = new ColliderComponent(this, 0, 0, nullptr, filter);
+	mColliderComponent->SetReportsContacts(true);
 	mRigidBodyComponent = new RigidBodyComponent(this, 1.0f, 0.0f, false);
 	Kill();
 }
@@ -93,24 +94,21 @@ void FurBallActor::OnUpdate(float deltaTime)
 	Vector2 velocity = mDirection * mSpeed;
 	mRigidBodyComponent->SetVelocity(velocity);
 
-	// Check for collisions
-	ColliderComponent* colliderComp = GetComponent<ColliderComponent>();
-	auto hitColliders = Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider());
-	for (auto collider : hitColliders)
-	{
-		auto enemyActor = collider->GetOwner();
-		auto enemyCharacter = dynamic_cast<Character*>(enemyActor);
-		if (enemyCharacter)
-		{
-			enemyCharacter->TakeDamage(mDamage);
-			Kill();
-			return;
-		}
-	}
-
 	mDelayedActions.Update(deltaTime);
 }
 
+void FurBallActor::OnCollisionEnter(ColliderComponent* other)
+{
+	// Several enemies can be entered on the same step, only the first one is hit
+	if (mDead) return;
+
+	auto enemyCharacter = dynamic_cast<Character*>(other->GetOwner());
+	if (!enemyCharacter) return;
+
+	enemyCharacter->TakeDamage(mDamage);
+	Kill();
+}
+
 void FurBallActor::Kill()
 {
 	mAnimatorComponent->SetVisible(false);
@@ -131,6 +129,7 @@ void FurBallActor::Awake(Vector2 position, Vector2 direction, float speed, int d
 	mAnimatorComponent->LoopAnimation(anim);
 	mColliderComponent->SetFilter(filter);
 	mColliderComponent->SetCollider(areaOfEffect);
+	mColliderComponent->SetEnabled(true);
 	mColliderComponent->SetDebugDrawIfDisabled(true);
 	mRigidBodyComponent->SetEnabled(true);
 
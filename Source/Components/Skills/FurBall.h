@@ -38,6 +38,7 @@ public:
 	~FurBallActor();
 
 	void OnUpdate(float deltaTime) override;
+	void OnCollisionEnter(class ColliderComponent* other) override;
 
 	void Kill() override;
 	void Awake(Vector2 position, Vector2 direction, float speed, int damage, CollisionFilter filter, Collider* areaOfEffect, float lifetime, std::string anim);
@@ -88,8 +88,8 @@ void StompActor::Execute()
 	ColliderComponent* colliderComp = GetComponent<ColliderComponent>();
 	Vector2 position = GetPosition();
 
-	auto hitColliders = Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider());
-	for (auto collider : hitColliders)
+	Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider(), mHitColliders);
+	for (auto collider : mHitColliders)
 	{
 		auto enemyActor = collider->GetOwner();
 		auto enemyCharacter = dynamic_cast<Character*>(enemyActor);
@@ -133,8 +133,8 @@ void WhiteBombActor::OnUpdate(float deltaTime)
 
 	// Check for collisions
 	ColliderComponent* colliderComp = GetComponent<ColliderComponent>();
-	auto hitColliders = Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider());
-	for (auto collider : hitColliders)
+	Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider(), mHitColliders);
+	for (auto collider : mHitColliders)
 	{
 		auto enemyActor = collider->GetOwner();
 		auto playerCharacter = dynamic_cast<ShadowCat*>(enemyActor);
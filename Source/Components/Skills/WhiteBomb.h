@@ -53,6 +53,7 @@ private:
 
 	class AnimatorComponent *mAnimatorComponent;
 	class ColliderComponent *mColliderComponent;
+	std::vector<class ColliderComponent*> mHitColliders;
 	class RigidBodyComponent *mRigidBodyComponent;
 
 	void AddDelayedAction(float delay, std::function<void()> action)
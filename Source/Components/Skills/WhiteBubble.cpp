@@ -108,8 +108,8 @@ void WhiteBubbleActor::OnUpdate(float deltaTime)
 		ColliderComponent* colliderComp = GetComponent<ColliderComponent>();
 		if (colliderComp && colliderComp->GetCollider())
 		{
-			auto hitColliders = Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider());
-			for (auto collider : hitColliders)
+			Physics::GetOverlappingColliders(GetGame(), colliderComp->GetCollider(), mHitColliders);
+			for (auto collider : mHitColliders)
 			{
 				auto actor = collider->GetOwner();
 				auto playerCharacter = dynamic_cast<ShadowCat*>(actor);
@@ -53,6 +53,7 @@ private:
 
 	class AnimatorComponent *mAnimatorComponent;
 	class ColliderComponent *mColliderComponent;
+	std::vector<class ColliderComponent*> mHitColliders;
 
 	void AddDelayedAction(float delay, std::function<void()> action)
 	{
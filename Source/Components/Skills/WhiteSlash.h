@@ -21,6 +21,7 @@ public:
 private:
     float mDamage;
     Collider* mAreaOfEffect;
+    std::vector<class ColliderComponent*> mHitColliders;
 
     nlohmann::json LoadSkillDataFromJSON(const std::string& fileName) override;
 };
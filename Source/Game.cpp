@@ -18,6 +18,8 @@
 #include "GameConstants.h"
 #include "Components/Drawing/DrawComponent.h"
 #include "Components/Physics/RigidBodyComponent.h"
+#include "Components/Physics/Physics.h"
+#include "Renderer/GLStateCache.h"
 #include "Random.h"
 #include "SkillFactory.h"
 #include "UI/Screens/MainMenu.h"
@@ -27,7 +29,6 @@
 #include "UI/Screens/GameOver.h"
 #include "UI/Screens/WinScreen.h"
 #include "Actors/Actor.h"
-#include "Actors/Block.h"
 #include "Actors/Spawner.h"
 #include "Actors/Characters/ShadowCat.h"
 #include "Components/AnimatedParticleSystemComponent.h"
@@ -51,6 +52,7 @@ Game::Game()
 	  mIsGodMode(false),
 	  mUpdatingActors(false),
 	  mCameraPos(Vector2::Zero),
+	  mVisibleDrawables(0),
 	  mLevelData(nullptr),
 	  mAudio(nullptr),
 	  mHUD(nullptr),
@@ -64,7 +66,12 @@ Game::Game()
 	  mShadowCat(nullptr),
 	  mController(nullptr),
 	  mLevelWidth(0),
-	  mLevelHeight(0)
+	  mLevelHeight(0),
+	  mColliderGrid(GameConstants::COLLISION_GRID_CELL_SIZE, GameConstants::COLLISION_GRID_MARGIN),
+	  mTileCollisionMap(static_cast<float>(GameConstants::TILE_SIZE)),
+	  mTileMapMesh(static_cast<float>(GameConstants::TILE_SIZE), GameConstants::TILE_CHUNK_SIZE),
+	  mDebugStatsTimer(0.0f),
+	  mPeakPhysicsAllocations(0)
 {
 }
 
@@ -111,6 +118,9 @@ bool Game::Initialize()
 	mRenderer = new Renderer(mWindow);
 	mRenderer->Initialize(GameConstants::WINDOW_WIDTH, GameConstants::WINDOW_HEIGHT);
 
+	// Sprite sheets, icons and HUD cards share a few atlas pages instead of a texture each
+	mRenderer->BuildTextureAtlas({"../Assets/Data/Animation/", "../Assets/Icons/", "../Assets/HUD/"});
+
 	for (int i = 0; i < SDL_NumJoysticks(); ++i)
 	{
 		if (SDL_IsGameController(i))
@@ -177,6 +187,10 @@ void Game::UnloadScene()
 		delete actor;
 	}
 
+	mTileCollisionMap.Clear();
+	mTileMapMesh.Clear();
+	mContactManager.Clear();
+
 	mUpgradeTreatActors.clear();
 	mStompActors.clear();
 	mFurBallActors.clear();
@@ -204,6 +218,10 @@ void Game::UnloadScene()
 	// Reset states
 	mLevelPortal = nullptr;
 	mCurrentBoss = nullptr;
+
+	// Nothing of the old scene holds its textures anymore, free them before the next one loads
+	mBackgroundTexture.Reset();
+	mRenderer->ReleaseUnusedTextures();
 }
 
 void Game::PauseGame()
@@ -370,6 +388,32 @@ void Game::SetScene(GameScene nextScene)
 		InitializeActors();
 		break;
 	}
+
+	mBackgroundTexture = TextureHandle(mRenderer->GetTexture(GetBackgroundPath()));
+}
+
+const char *Game::GetBackgroundPath() const
+{
+	switch (mCurrentScene)
+	{
+	case GameScene::MainMenu:
+		return "../Assets/HUD/Background/MainMenuBackground.png";
+	case GameScene::Level1:
+		return "../Assets/Levels/Level1/Level1Background.png";
+	case GameScene::Level1_Boss:
+		return "../Assets/Levels/Level1_Boss/Level1_Boss_Background.png";
+	case GameScene::Level2:
+		return "../Assets/Levels/Level2/Level2Background.png";
+	case GameScene::Level2_Boss:
+		return "../Assets/Levels/Level2_Boss/Level2_Boss_Background.png";
+	case GameScene::Level3:
+		return "../Assets/Levels/Level3/Level3Background.png";
+	case GameScene::Level3_Boss:
+		return "../Assets/Levels/Level3_Boss/Level3_Boss_Background.png";
+	case GameScene::Lobby:
+	default:
+		return "../Assets/Levels/Lobby/LobbyBackground.png";
+	}
 }
 
 GroundType Game::GetGroundType() const
@@ -452,6 +496,24 @@ void Game::InitializeActors()
 	}
 }
 
+void Game::BuildMergedWallColliders()
+{
+	std::vector<TileRect> rects;
+	mTileCollisionMap.GetMergedRects(rects);
+
+	for (const auto &rect : rects)
+	{
+		Vector2 min = mTileCollisionMap.GetTileMin(rect.minX, rect.minY);
+		Vector2 max = mTileCollisionMap.GetTileMax(rect.maxX, rect.maxY);
+
+		auto wall = new Actor(this);
+		wall->SetPosition((min + max) * 0.5f);
+		new ColliderComponent(wall, 0, 0, new AABBCollider(max.x - min.x, max.y - min.y), mTileCollisionMap.GetFilter(), true);
+	}
+
+	SDL_Log("[BUILD] Merged %d wall tiles into %d colliders", mTileCollisionMap.CountSolidTiles(), static_cast<int>(rects.size()));
+}
+
 int **Game::LoadLevel(const std::string &fileName, int &outWidth, int &outHeight)
 {
 	std::ifstream levelFile(fileName);
@@ -528,6 +590,16 @@ int **Game::LoadLevel(const std::string &fileName, int &outWidth, int &outHeight
 
 void Game::BuildLevel(int **levelData, int width, int height)
 {
+	// Walls collide through the baked tile map (or colliders merged from it)
+	mTileCollisionMap.Build(levelData, width, height);
+
+	// Floors and walls are drawn from baked chunks instead of one actor per tile
+	if (mTileMapMesh.Build(mRenderer, "../Assets/Data/Animation/BlockAnim.json", levelData, width, height))
+		SDL_Log("[BUILD] Baked %d tiles into %d chunk meshes", mTileMapMesh.GetTileCount(), mTileMapMesh.GetChunkCount());
+
+	if (GameConstants::STATIC_COLLISION_MODE == StaticCollisionMode::MergedColliders)
+		BuildMergedWallColliders();
+
 	for (int i = 0; i < height; ++i)
 	{
 		for (int j = 0; j < width; ++j)
@@ -559,30 +631,11 @@ void Game::BuildLevel(int **levelData, int width, int height)
 			{
 				auto sylvesterCat = new SylvesterCat(this, position);
 			}
-			// Blocks (excluding tile 9 - carpet/portal, handled by LevelPortal actor)
-			else if (tileID >= 4 && tileID <= 10)
-			{
-				if (tileID == 9)
-				{
-					SDL_Log("[BUILD] Skipping tile 9 (carpet) at (%.1f, %.1f) - will be rendered by LevelPortal", position.x, position.y);
-				}
-				else
-				{
-					auto block = new Block(this, tileID);
-					block->SetPosition(position);
-				}
-			}
 			// Dummy
 			else if (tileID == 11)
 			{
 				auto dummy = new Dummy(this, position);
 			}
-			// Walls (paredes)
-			else if (tileID >= 16 && tileID <= 27)
-			{
-				auto block = new Block(this, tileID);
-				block->SetPosition(position);
-			}
 			else if (tileID == 12)
 			{
 				auto boss = new WhiteBoss(this, position);
@@ -631,10 +684,14 @@ void Game::RunLoop()
 
 		mTicksCount = SDL_GetTicks();
 
+		Physics::ResetFrameStats();
+
 		ProcessInput();
 		UpdateGame(deltaTime);
 		GenerateOutput();
 
+		UpdateDebugStats(deltaTime);
+
 		// Sleep to maintain frame rate
 		int sleepTime = (1000 / GameConstants::FPS) - (SDL_GetTicks() - mTicksCount);
 		if (sleepTime > 0)
@@ -904,6 +961,12 @@ void Game::UpdateGame(float deltaTime)
 
 void Game::UpdateActors(float deltaTime)
 {
+	// Catch up with anything moved outside of a rigid body since the last frame
+	for (auto collider : mColliders)
+	{
+		collider->SyncBroadphase();
+	}
+
 	mUpdatingActors = true;
 	for (auto actor : mActors)
 	{
@@ -911,6 +974,9 @@ void Game::UpdateActors(float deltaTime)
 	}
 	mUpdatingActors = false;
 
+	// Everything has moved for this frame, raise the collision events
+	mContactManager.Step(this);
+
 	for (auto pending : mPendingActors)
 	{
 		mActors.emplace_back(pending);
@@ -932,6 +998,35 @@ void Game::UpdateActors(float deltaTime)
 	}
 }
 
+void Game::UpdateDebugStats(float deltaTime)
+{
+	mPeakPhysicsAllocations = std::max(mPeakPhysicsAllocations, Physics::GetFrameAllocations());
+
+	mDebugStatsTimer += deltaTime;
+	if (mDebugStatsTimer < 1.0f)
+		return;
+
+	if (mIsDebugging)
+	{
+		SDL_Log("[STATS] Physics allocations: %d last frame, %d peak",
+				Physics::GetFrameAllocations(), mPeakPhysicsAllocations);
+		SDL_Log("[STATS] Rigid bodies: %d awake of %d",
+				Physics::GetAwakeRigidBodies(), Physics::GetRigidBodies());
+		SDL_Log("[STATS] Draw calls: %d, GL state changes: %d issued, %d skipped",
+				mRenderer->GetDrawCalls(), GLStateCache::GetIssuedCalls(), GLStateCache::GetSkippedCalls());
+		SDL_Log("[STATS] Contacts: %d active, %d pairs tested, %d skipped",
+				mContactManager.GetContactCount(), mContactManager.GetTestedPairs(), mContactManager.GetSkippedPairs());
+		SDL_Log("[STATS] Drawables: %d visible of %d",
+				mVisibleDrawables, static_cast<int>(mDrawables.size()));
+		SDL_Log("[STATS] Font faces open: %d", Font::GetOpenFaces());
+		SDL_Log("[STATS] Textures: %d pending, %.1f MB resident",
+				mRenderer->GetPendingTextures(), mRenderer->GetResidentTextureBytes() / (1024.0 * 1024.0));
+	}
+
+	mDebugStatsTimer = 0.0f;
+	mPeakPhysicsAllocations = 0;
+}
+
 void Game::UpdateCamera()
 {
 	if (mShadowCat)
@@ -1015,10 +1110,8 @@ void Game::RemovePersistentActor(Actor *actor)
 
 void Game::AddDrawable(class DrawComponent *drawable)
 {
+	// Ordering happens once per frame in the render queue
 	mDrawables.emplace_back(drawable);
-
-	std::sort(mDrawables.begin(), mDrawables.end(), [](DrawComponent *a, DrawComponent *b)
-			  { return a->GetDrawOrder() < b->GetDrawOrder(); });
 }
 
 void Game::RemoveDrawable(class DrawComponent *drawable)
@@ -1036,6 +1129,8 @@ void Game::RemoveCollider(ColliderComponent *collider)
 {
 	auto iter = std::find(mColliders.begin(), mColliders.end(), collider);
 	mColliders.erase(iter);
+	mColliderGrid.Remove(collider, collider->GetGridProxy());
+	mContactManager.RemoveCollider(collider);
 }
 
 void Game::GenerateOutput()
@@ -1043,41 +1138,7 @@ void Game::GenerateOutput()
 	// Clear back buffer
 	mRenderer->Clear();
 
-	// Get background texture based on current scene
-	std::string backgroundPath;
-
-	switch (mCurrentScene)
-	{
-	case GameScene::MainMenu:
-		backgroundPath = "../Assets/HUD/Background/MainMenuBackground.png";
-		break;
-	case GameScene::Lobby:
-		backgroundPath = "../Assets/Levels/Lobby/LobbyBackground.png";
-		break;
-	case GameScene::Level1:
-		backgroundPath = "../Assets/Levels/Level1/Level1Background.png";
-		break;
-	case GameScene::Level1_Boss:
-		backgroundPath = "../Assets/Levels/Level1_Boss/Level1_Boss_Background.png";
-		break;
-	case GameScene::Level2:
-		backgroundPath = "../Assets/Levels/Level2/Level2Background.png";
-		break;
-	case GameScene::Level2_Boss:
-		backgroundPath = "../Assets/Levels/Level2_Boss/Level2_Boss_Background.png";
-		break;
-	case GameScene::Level3:
-		backgroundPath = "../Assets/Levels/Level3/Level3Background.png";
-		break;
-	case GameScene::Level3_Boss:
-		backgroundPath = "../Assets/Levels/Level3_Boss/Level3_Boss_Background.png";
-		break;
-	default:
-		backgroundPath = "../Assets/Levels/Lobby/LobbyBackground.png";
-		break;
-	}
-
-	Texture *backgroundTexture = mRenderer->GetTexture(backgroundPath);
+	Texture *backgroundTexture = mBackgroundTexture.Get();
 	if (backgroundTexture)
 	{
 		// Main menu static image overrides scaling
@@ -1118,8 +1179,28 @@ void Game::GenerateOutput()
 		}
 	}
 
+	Vector2 viewSize(static_cast<float>(GameConstants::WINDOW_WIDTH), static_cast<float>(GameConstants::WINDOW_HEIGHT));
+	mTileMapMesh.Draw(mRenderer, mCameraPos, viewSize);
+
+	// Skip everything outside the camera view before it reaches the queue
+	Vector2 margin(GameConstants::DRAW_CULL_MARGIN, GameConstants::DRAW_CULL_MARGIN);
+	Vector2 viewMin = mCameraPos - margin;
+	Vector2 viewMax = mCameraPos + viewSize + margin;
+
+	mRenderQueue.Clear();
+	mVisibleDrawables = 0;
 	for (auto drawable : mDrawables)
 	{
+		if (!drawable->IsInView(viewMin, viewMax)) continue;
+
+		drawable->EmitRenderCommands(mRenderQueue);
+		++mVisibleDrawables;
+	}
+	mRenderQueue.Sort();
+
+	for (const auto &command : mRenderQueue.GetCommands())
+	{
+		auto drawable = command.drawable;
 		drawable->Draw(mRenderer);
 
 		auto actor = drawable->GetOwner();
@@ -1146,6 +1227,12 @@ void Game::GenerateOutput()
 			comp->ComponentDraw(mRenderer);
 	}
 
+	if (mIsDebugging && GameConstants::STATIC_COLLISION_MODE == StaticCollisionMode::TileMap)
+		mTileCollisionMap.DebugDraw(mRenderer, mCameraPos);
+
+	if (mIsDebugging && mDebugActor)
+		mDebugActor->DrawPolygons(mRenderer);
+
 	// Draw UI (TODO: unify in a single draw function and remove mDrawables, add to renderer)
 	mRenderer->DrawAllUI();
 
@@ -1160,6 +1247,9 @@ void Game::Shutdown()
 		delete mActors.back();
 	}
 
+	// Chunk meshes own GL buffers, release them while the context is alive
+	mTileMapMesh.Clear();
+
 	if (mController)
 	{
 		SDL_GameControllerClose(mController);
@@ -1184,6 +1274,8 @@ void Game::Shutdown()
 	}
 	mUIStack.clear();
 
+	mBackgroundTexture.Reset();
+
 	mRenderer->Shutdown();
 	delete mRenderer;
 	mRenderer = nullptr;
@@ -15,6 +15,12 @@
 #include "Components/Skills/WhiteBomb.h"
 #include "Components/Skills/WhiteBubble.h"
 #include "Components/Skills/Stomp.h"
+#include "Components/Physics/SpatialGrid.h"
+#include "Components/Physics/TileCollisionMap.h"
+#include "Components/Physics/ContactManager.h"
+#include "Renderer/RenderQueue.h"
+#include "Renderer/TileMapMesh.h"
+#include "Renderer/TextureHandle.h"
 #include "Actors/UpgradeTreat.h"
 
 enum class GameScene
@@ -29,6 +35,13 @@ enum class GameScene
 	Level3_Boss
 };
 
+// How wall tiles collide
+enum class StaticCollisionMode
+{
+	TileMap,        // Baked occupancy grid, tested per touched tile
+	MergedColliders // Greedy-merged static AABB colliders in the broadphase
+};
+
 enum class GroundType
 {
 	Grass,
@@ -86,11 +99,16 @@ public:
 	void AddDrawable(class DrawComponent *drawable);
 	void RemoveDrawable(class DrawComponent *drawable);
 	std::vector<class DrawComponent *> &GetDrawables() { return mDrawables; }
+	// Drawables that passed view culling during the last frame
+	int GetVisibleDrawables() const { return mVisibleDrawables; }
 
 	// Collider functions
 	void AddCollider(class ColliderComponent *collider);
 	void RemoveCollider(class ColliderComponent *collider);
 	std::vector<class ColliderComponent *> &GetColliders() { return mColliders; }
+	SpatialGrid &GetColliderGrid() { return mColliderGrid; }
+	const TileCollisionMap &GetTileCollisionMap() const { return mTileCollisionMap; }
+	ContactManager &GetContactManager() { return mContactManager; }
 
 	// Camera functions
 	Vector2 &GetCameraPos() { return mCameraPos; };
@@ -137,10 +155,13 @@ private:
 	void UpdateGame(float deltaTime);
 	void UpdateCamera();
 	void GenerateOutput();
+	void UpdateDebugStats(float deltaTime);
 
 	// Level loading
 	int **LoadLevel(const std::string &fileName, int &outWidth, int &outHeight);
 	void BuildLevel(int **levelData, int width, int height);
+	void BuildMergedWallColliders();
+	const char *GetBackgroundPath() const;
 
 	// Current level dimensions
 	int mLevelWidth;
@@ -156,9 +177,22 @@ private:
 
 	// All the draw components
 	std::vector<class DrawComponent *> mDrawables;
+	RenderQueue mRenderQueue;
+	int mVisibleDrawables;
 
 	// All the collision components
 	std::vector<class ColliderComponent *> mColliders;
+	SpatialGrid mColliderGrid;
+	ContactManager mContactManager;
+
+	// Static wall collision baked from the level data
+	TileCollisionMap mTileCollisionMap;
+
+	// Floor and wall tiles baked into chunk meshes
+	TileMapMesh mTileMapMesh;
+
+	// Held for the whole scene so the background is never evicted while on screen
+	TextureHandle mBackgroundTexture;
 
 	// All UI screens in the game
 	std::vector<class UIScreen *> mUIStack;
@@ -215,4 +249,8 @@ private:
 	bool mIsDebugging;
 	bool mIsGodMode;
 	DebugActor *mDebugActor;
+
+	// Per-second stats logged while debugging
+	float mDebugStatsTimer;
+	int mPeakPhysicsAllocations;
 };
@@ -7,11 +7,19 @@ namespace GameConstants
     constexpr int WINDOW_WIDTH = 1280;
     constexpr int WINDOW_HEIGHT = 720;
     constexpr int FPS = 60;
+    // Milliseconds per frame spent uploading streamed textures
+    constexpr float TEXTURE_UPLOAD_BUDGET_MS = 2.0f;
+    // Resident texture memory above which unreferenced textures are evicted
+    constexpr size_t TEXTURE_MEMORY_BUDGET = 128 * 1024 * 1024;
 
     // Level settings
     constexpr int LEVEL_WIDTH = 21;
     constexpr int LEVEL_HEIGHT = 13;
     constexpr int TILE_SIZE = 64;
+    // Tiles per side of each baked tile mesh chunk
+    constexpr int TILE_CHUNK_SIZE = 16;
+    // Drawables this far outside the view are still drawn, covers effects hanging off their bounds
+    constexpr float DRAW_CULL_MARGIN = TILE_SIZE;
     constexpr int SPAWN_DISTANCE = 700;
 
     // Physics constants
@@ -19,6 +27,14 @@ namespace GameConstants
     constexpr float MAX_SPEED_Y = 750.0f;
     constexpr float GRAVITY = 0.0f;
 
+    // Broadphase grid settings
+    constexpr float COLLISION_GRID_CELL_SIZE = TILE_SIZE * 2.0f;
+    constexpr float COLLISION_GRID_MARGIN = 8.0f;
+    constexpr StaticCollisionMode STATIC_COLLISION_MODE = StaticCollisionMode::TileMap;
+
+    // Seconds a rigid body has to stay still before it falls asleep
+    constexpr float RIGID_BODY_SLEEP_TIME = 0.5f;
+
     // Input constants
     constexpr int JOYSTICK_DEAD_ZONE = 8000;
 
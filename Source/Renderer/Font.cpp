@@ -1,6 +1,8 @@
 #include "Font.h"
-#include "Texture.h"
+#include "GlyphAtlas.h"
 #include <vector>
+#include <fstream>
+#include <algorithm>
 #include "../Game.h"
 
 Font::Font()
@@ -13,63 +15,86 @@ Font::~Font()
 
 bool Font::Load(const std::string& fileName)
 {
-	// We support these font sizes
-	std::vector<int> fontSizes = {8,  9,  10, 11, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32,
-								  34, 36, 38, 40, 42, 44, 46, 48, 52, 56, 60, 64, 68, 72};
-
-	for (auto& size : fontSizes)
+	// Faces are opened lazily, just make sure the file is there
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open())
 	{
-		TTF_Font* font = TTF_OpenFont(fileName.c_str(), size);
-		if (font == nullptr)
-		{
-			SDL_Log("Failed to load font %s in size %d", fileName.c_str(), size);
-			return false;
-		}
-		mFontData.emplace(size, font);
+		SDL_Log("Failed to load font %s", fileName.c_str());
+		return false;
 	}
+
+	mFileName = fileName;
 	return true;
 }
 
 void Font::Unload()
 {
+	for (auto& atlas : mAtlases)
+	{
+		delete atlas.second;
+	}
+	mAtlases.clear();
+
 	for (auto& font : mFontData)
 	{
 		TTF_CloseFont(font.second);
+		--sOpenFaces;
 	}
+	mFontData.clear();
 }
 
-Texture* Font::RenderText(const std::string& text, const Vector3& color /*= Color::White*/,
-						  int pointSize /*= 24*/, unsigned wrapLength /*= 900*/)
+TTF_Font* Font::GetFontData(int pointSize)
 {
-	Texture* texture = nullptr;
-
-	// Convert to SDL_Color
-	SDL_Color sdlColor;
-	// Swap red and blue so we get RGBA instead of BGRA
-	sdlColor.b = static_cast<Uint8>(color.x * 255);
-	sdlColor.g = static_cast<Uint8>(color.y * 255);
-	sdlColor.r = static_cast<Uint8>(color.z * 255);
-	sdlColor.a = 255;
-
-	// Find the font data for this point size
 	auto iter = mFontData.find(pointSize);
 	if (iter != mFontData.end())
 	{
-		TTF_Font* font = iter->second;
-		// Draw this to a surface (blended for alpha)
-		SDL_Surface* surf = TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), sdlColor, wrapLength);
-		if (surf != nullptr)
-		{
-			// Convert from surface to texture
-			texture = new Texture();
-			texture->CreateFromSurface(surf);
-			SDL_FreeSurface(surf);
-		}
+		return iter->second;
 	}
-	else
+
+	// We support these font sizes
+	static const std::vector<int> fontSizes = {8,  9,  10, 11, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32,
+											   34, 36, 38, 40, 42, 44, 46, 48, 52, 56, 60, 64, 68, 72};
+
+	if (std::find(fontSizes.begin(), fontSizes.end(), pointSize) == fontSizes.end())
 	{
 		SDL_Log("Point size %d is unsupported", pointSize);
+		return nullptr;
+	}
+
+	TTF_Font* font = TTF_OpenFont(mFileName.c_str(), pointSize);
+	if (font == nullptr)
+	{
+		SDL_Log("Failed to load font %s in size %d", mFileName.c_str(), pointSize);
+		return nullptr;
+	}
+
+	++sOpenFaces;
+	mFontData.emplace(pointSize, font);
+	return font;
+}
+
+GlyphAtlas* Font::GetGlyphAtlas(int pointSize)
+{
+	auto atlasIter = mAtlases.find(pointSize);
+	if (atlasIter != mAtlases.end())
+	{
+		return atlasIter->second;
+	}
+
+	TTF_Font* font = GetFontData(pointSize);
+	if (!font)
+	{
+		return nullptr;
+	}
+
+	GlyphAtlas* atlas = new GlyphAtlas();
+	if (!atlas->Build(font))
+	{
+		SDL_Log("Failed to build glyph atlas for point size %d", pointSize);
+		delete atlas;
+		return nullptr;
 	}
 
-	return texture;
+	mAtlases.emplace(pointSize, atlas);
+	return atlas;
 }
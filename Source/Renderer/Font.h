@@ -2,7 +2,6 @@
 #include <string>
 #include <unordered_map>
 #include <SDL_ttf.h>
-#include "../Math.h"
 
 class Font
 {
@@ -10,15 +9,26 @@ public:
 	Font();
 	~Font();
 
-	// Load/unload from a file
+	// Load/unload from a file. Each point size is only opened the first time it is used
 	bool Load(const std::string& fileName);
 	void Unload();
 
-	// Given string and this font, draw to a texture
-	class Texture* RenderText(const std::string& text, const Vector3& color = Color::White,
-							  int pointSize = 30, unsigned wrapLength = 900);
+	// Glyph atlas for this point size, built the first time it is asked for
+	class GlyphAtlas* GetGlyphAtlas(int pointSize);
+
+	// Faces currently open across every font and point size
+	static int GetOpenFaces() { return sOpenFaces; }
 
 private:
+	// Opens the face for this point size on first use
+	TTF_Font* GetFontData(int pointSize);
+
+	std::string mFileName;
+
 	// Map of point sizes to font data
 	std::unordered_map<int, TTF_Font*> mFontData;
+	// Map of point sizes to their glyph atlas
+	std::unordered_map<int, class GlyphAtlas*> mAtlases;
+
+	inline static int sOpenFaces = 0;
 };
@@ -0,0 +1,122 @@
+#include "GLStateCache.h"
+#include <SDL.h>
+
+void GLStateCache::UseProgram(GLuint program)
+{
+    if (sProgram == program)
+    {
+        ++sSkippedCalls;
+        return;
+    }
+
+    glUseProgram(program);
+    sProgram = program;
+    ++sIssuedCalls;
+}
+
+void GLStateCache::BindVertexArray(GLuint vertexArray)
+{
+    if (sVertexArray == vertexArray)
+    {
+        ++sSkippedCalls;
+        return;
+    }
+
+    // The element buffer is part of the vertex array state, so it comes along with it
+    glBindVertexArray(vertexArray);
+    sVertexArray = vertexArray;
+    ++sIssuedCalls;
+}
+
+void GLStateCache::BindTexture(int unit, GLuint texture)
+{
+    if (unit < 0 || unit >= MAX_TEXTURE_UNITS)
+    {
+        SDL_Log("Texture unit %d is out of range", unit);
+        return;
+    }
+
+    if (sTextures[unit] == texture)
+    {
+        ++sSkippedCalls;
+        return;
+    }
+
+    if (sActiveTextureUnit != unit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        sActiveTextureUnit = unit;
+        ++sIssuedCalls;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    sTextures[unit] = texture;
+    ++sIssuedCalls;
+}
+
+void GLStateCache::SetBlend(bool enabled, GLenum srcFactor, GLenum dstFactor)
+{
+    if (sBlendEnabled != enabled)
+    {
+        if (enabled) glEnable(GL_BLEND);
+        else glDisable(GL_BLEND);
+
+        sBlendEnabled = enabled;
+        ++sIssuedCalls;
+    }
+    else
+    {
+        ++sSkippedCalls;
+    }
+
+    if (sBlendSrc != srcFactor || sBlendDst != dstFactor)
+    {
+        glBlendFunc(srcFactor, dstFactor);
+        sBlendSrc = srcFactor;
+        sBlendDst = dstFactor;
+        ++sIssuedCalls;
+    }
+    else
+    {
+        ++sSkippedCalls;
+    }
+}
+
+void GLStateCache::ForgetProgram(GLuint program)
+{
+    // GL keeps a deleted program in use until another one is bound, but its name can be reused
+    if (sProgram == program) sProgram = 0;
+}
+
+void GLStateCache::ForgetVertexArray(GLuint vertexArray)
+{
+    if (sVertexArray == vertexArray) sVertexArray = 0;
+}
+
+void GLStateCache::ForgetTexture(GLuint texture)
+{
+    for (auto& bound : sTextures)
+    {
+        if (bound == texture) bound = 0;
+    }
+}
+
+void GLStateCache::Reset()
+{
+    sProgram = 0;
+    sVertexArray = 0;
+    sActiveTextureUnit = 0;
+    for (auto& bound : sTextures) bound = 0;
+
+    sBlendEnabled = false;
+    sBlendSrc = GL_ONE;
+    sBlendDst = GL_ZERO;
+}
+
+void GLStateCache::EndFrame()
+{
+    sLastIssuedCalls = sIssuedCalls;
+    sLastSkippedCalls = sSkippedCalls;
+    sIssuedCalls = 0;
+    sSkippedCalls = 0;
+}
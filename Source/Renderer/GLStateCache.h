@@ -0,0 +1,45 @@
+#pragma once
+#include <GL/glew.h>
+
+// Remembers the program, vertex array, texture and blend state we set last, so setting the
+// same state again skips the GL call. Everything in the renderer binds through here.
+// GL reuses the names of deleted objects, so those have to be forgotten when deleted
+class GLStateCache
+{
+public:
+    GLStateCache() = delete; // Prevent instantiation
+
+    static void UseProgram(GLuint program);
+    static void BindVertexArray(GLuint vertexArray);
+    static void BindTexture(int unit, GLuint texture);
+    static void SetBlend(bool enabled, GLenum srcFactor = GL_SRC_ALPHA, GLenum dstFactor = GL_ONE_MINUS_SRC_ALPHA);
+
+    static void ForgetProgram(GLuint program);
+    static void ForgetVertexArray(GLuint vertexArray);
+    static void ForgetTexture(GLuint texture);
+
+    // Call when a new context is created, its state starts out at the GL defaults
+    static void Reset();
+
+    // Keeps this frame's counts for the debug stats and starts counting again
+    static void EndFrame();
+    static int GetIssuedCalls() { return sLastIssuedCalls; }
+    static int GetSkippedCalls() { return sLastSkippedCalls; }
+
+private:
+    static constexpr int MAX_TEXTURE_UNITS = 8;
+
+    inline static GLuint sProgram = 0;
+    inline static GLuint sVertexArray = 0;
+    inline static int sActiveTextureUnit = 0;
+    inline static GLuint sTextures[MAX_TEXTURE_UNITS] = {};
+
+    inline static bool sBlendEnabled = false;
+    inline static GLenum sBlendSrc = GL_ONE;
+    inline static GLenum sBlendDst = GL_ZERO;
+
+    inline static int sIssuedCalls = 0;
+    inline static int sSkippedCalls = 0;
+    inline static int sLastIssuedCalls = 0;
+    inline static int sLastSkippedCalls = 0;
+};
@@ -0,0 +1,206 @@
+#include "GlyphAtlas.h"
+#include "Texture.h"
+#include <algorithm>
+#include <cmath>
+
+GlyphAtlas::GlyphAtlas()
+	: mFont(nullptr)
+	, mTexture(nullptr)
+	, mGlyphs()
+	, mLineHeight(0.0f)
+	, mLineSkip(0.0f)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	Unload();
+}
+
+bool GlyphAtlas::Build(TTF_Font* font)
+{
+	Unload();
+
+	mFont = font;
+	mLineHeight = static_cast<float>(TTF_FontHeight(font));
+	mLineSkip = static_cast<float>(TTF_FontLineSkip(font));
+
+	// White glyphs, the color comes from the vertices
+	SDL_Color white = {255, 255, 255, 255};
+
+	SDL_Surface* surfaces[GLYPH_COUNT] = {};
+	SDL_Rect rects[GLYPH_COUNT] = {};
+	int advances[GLYPH_COUNT] = {};
+
+	// Shelf packing, one row after the other, with a pixel of padding so filtering doesn't bleed
+	int x = 0;
+	int y = 0;
+	int rowHeight = 0;
+	for (int ch = FIRST_GLYPH; ch < GLYPH_COUNT; ++ch)
+	{
+		// Skip DEL and the C1 control range
+		if (ch >= 127 && ch < 160) continue;
+
+		int minX, maxX, minY, maxY;
+		if (TTF_GlyphMetrics(font, static_cast<Uint16>(ch), &minX, &maxX, &minY, &maxY, &advances[ch]) != 0)
+			continue;
+
+		SDL_Surface* surface = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(ch), white);
+		if (!surface) continue;
+
+		if (x + surface->w > ATLAS_WIDTH)
+		{
+			x = 0;
+			y += rowHeight + 1;
+			rowHeight = 0;
+		}
+
+		surfaces[ch] = surface;
+		rects[ch] = SDL_Rect{x, y, surface->w, surface->h};
+
+		x += surface->w + 1;
+		rowHeight = std::max(rowHeight, surface->h);
+	}
+
+	int atlasHeight = 1;
+	while (atlasHeight < y + rowHeight) atlasHeight *= 2;
+
+	SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+	if (!atlas)
+	{
+		SDL_Log("Failed to create glyph atlas surface: %s", SDL_GetError());
+		for (auto surface : surfaces)
+			if (surface) SDL_FreeSurface(surface);
+		return false;
+	}
+
+	float width = static_cast<float>(ATLAS_WIDTH);
+	float height = static_cast<float>(atlasHeight);
+	for (int ch = 0; ch < GLYPH_COUNT; ++ch)
+	{
+		if (!surfaces[ch]) continue;
+
+		// Copy the coverage as is instead of blending it over the empty atlas
+		SDL_SetSurfaceBlendMode(surfaces[ch], SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(surfaces[ch], nullptr, atlas, &rects[ch]);
+		SDL_FreeSurface(surfaces[ch]);
+
+		const SDL_Rect& rect = rects[ch];
+		mGlyphs[ch].uv = Vector4(rect.x / width, rect.y / height, rect.w / width, rect.h / height);
+		mGlyphs[ch].width = static_cast<float>(rect.w);
+		mGlyphs[ch].advance = static_cast<float>(advances[ch]);
+		mGlyphs[ch].valid = true;
+	}
+
+	mTexture = new Texture();
+	mTexture->CreateFromSurface(atlas);
+	SDL_FreeSurface(atlas);
+
+	return true;
+}
+
+void GlyphAtlas::Unload()
+{
+	if (mTexture)
+	{
+		mTexture->Unload();
+		delete mTexture;
+		mTexture = nullptr;
+	}
+
+	for (auto& glyph : mGlyphs)
+		glyph.valid = false;
+}
+
+Uint16 GlyphAtlas::NextCharacter(const std::string& text, size_t& index)
+{
+	auto lead = static_cast<unsigned char>(text[index++]);
+	if (lead < 0x80) return lead;
+
+	// Two byte sequences cover the rest of Latin-1, skip over anything longer
+	int extra = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : 1;
+	Uint16 ch = lead & 0x1F;
+	for (int i = 0; i < extra && index < text.size(); ++i)
+		ch = static_cast<Uint16>((ch << 6) | (static_cast<unsigned char>(text[index++]) & 0x3F));
+
+	return (extra == 1 && ch < GLYPH_COUNT) ? ch : '?';
+}
+
+float GlyphAtlas::MeasureWord(const std::string& text, size_t start, size_t end) const
+{
+	float width = 0.0f;
+	for (size_t i = start; i < end;)
+	{
+		Uint16 ch = NextCharacter(text, i);
+		if (ch < GLYPH_COUNT && mGlyphs[ch].valid) width += mGlyphs[ch].advance;
+	}
+	return width;
+}
+
+Vector2 GlyphAtlas::LayoutText(const std::string& text, unsigned wrapLength, std::vector<GlyphQuad>& outQuads) const
+{
+	outQuads.clear();
+	if (!mTexture || text.empty()) return Vector2::Zero;
+
+	float penX = 0.0f;
+	float lineEnd = 0.0f;
+	float maxWidth = 0.0f;
+	int line = 0;
+	Uint16 previous = 0;
+
+	auto newLine = [&]()
+	{
+		maxWidth = std::max(maxWidth, lineEnd);
+		penX = 0.0f;
+		lineEnd = 0.0f;
+		previous = 0;
+		++line;
+	};
+
+	size_t i = 0;
+	while (i < text.size())
+	{
+		if (text[i] == '\n')
+		{
+			newLine();
+			++i;
+			continue;
+		}
+
+		// Spaces only move the pen, they never start a line that wrapped
+		if (text[i] == ' ')
+		{
+			if (mGlyphs[' '].valid) penX += mGlyphs[' '].advance;
+			previous = ' ';
+			++i;
+			continue;
+		}
+
+		size_t end = text.find_first_of(" \n", i);
+		if (end == std::string::npos) end = text.size();
+
+		if (wrapLength > 0 && lineEnd > 0.0f && penX + MeasureWord(text, i, end) > wrapLength)
+			newLine();
+
+		while (i < end)
+		{
+			Uint16 ch = NextCharacter(text, i);
+			if (ch >= GLYPH_COUNT || !mGlyphs[ch].valid) ch = '?';
+			if (!mGlyphs[ch].valid) continue;
+
+			if (previous)
+				penX += static_cast<float>(TTF_GetFontKerningSizeGlyphs(mFont, previous, ch));
+
+			const Glyph& glyph = mGlyphs[ch];
+			float top = line * mLineSkip;
+			outQuads.push_back(GlyphQuad{Vector2(penX, top), Vector2(penX + glyph.width, top + mLineHeight), glyph.uv});
+
+			penX += glyph.advance;
+			lineEnd = penX;
+			previous = ch;
+		}
+	}
+
+	maxWidth = std::max(maxWidth, lineEnd);
+	return Vector2(std::ceil(maxWidth), line * mLineSkip + mLineHeight);
+}
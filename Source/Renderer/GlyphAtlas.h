@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <SDL_ttf.h>
+#include "../Math.h"
+
+// Glyph quad laid out inside a text box, relative to its top-left corner
+struct GlyphQuad
+{
+	Vector2 min;
+	Vector2 max;
+	Vector4 uv;
+};
+
+// Every Latin-1 glyph of one font and point size rasterized once, in white, into a single texture.
+// Text is then laid out as quads from the cached metrics and tinted per vertex,
+// so changing a label never touches SDL_ttf or allocates a texture
+class GlyphAtlas
+{
+public:
+	GlyphAtlas();
+	~GlyphAtlas();
+
+	bool Build(TTF_Font* font);
+	void Unload();
+
+	// Wraps on spaces like TTF_RenderUTF8_Blended_Wrapped and returns the size of the text box
+	Vector2 LayoutText(const std::string& text, unsigned wrapLength, std::vector<GlyphQuad>& outQuads) const;
+
+	class Texture* GetTexture() const { return mTexture; }
+
+private:
+	struct Glyph
+	{
+		Vector4 uv;
+		float width;
+		float advance;
+		bool valid;
+	};
+
+	static constexpr int FIRST_GLYPH = 32;
+	static constexpr int GLYPH_COUNT = 256;
+	static constexpr int ATLAS_WIDTH = 1024;
+
+	// Decodes the next UTF-8 character, anything outside Latin-1 comes back as '?'
+	static Uint16 NextCharacter(const std::string& text, size_t& index);
+
+	float MeasureWord(const std::string& text, size_t start, size_t end) const;
+
+	TTF_Font* mFont;
+	class Texture* mTexture;
+
+	Glyph mGlyphs[GLYPH_COUNT];
+	float mLineHeight;
+	float mLineSkip;
+};
@@ -0,0 +1,77 @@
+#include "LineBatch.h"
+#include <GL/glew.h>
+#include "Shader.h"
+#include "GLStateCache.h"
+
+LineBatch::LineBatch(Shader* shader, int maxLines)
+    : mShader(shader)
+    , mMaxLines(maxLines)
+    , mLineCount(0)
+    , mVertexArray(0)
+    , mVertexBuffer(0)
+{
+    mVertices.reserve(static_cast<size_t>(maxLines) * 2 * FLOATS_PER_VERTEX);
+
+    const size_t VERTEX_SIZE = FLOATS_PER_VERTEX * sizeof(float);
+
+    glGenVertexArrays(1, &mVertexArray);
+    GLStateCache::BindVertexArray(mVertexArray);
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, maxLines * 2 * VERTEX_SIZE, nullptr, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)0);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(2 * sizeof(float)));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(4 * sizeof(float)));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(7 * sizeof(float)));
+
+    GLStateCache::BindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+LineBatch::~LineBatch()
+{
+    glDeleteBuffers(1, &mVertexBuffer);
+    GLStateCache::ForgetVertexArray(mVertexArray);
+    glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void LineBatch::AddLine(const Vector2& start, const Vector2& end, const Vector3& color)
+{
+    if (IsFull()) return;
+
+    mVertices.insert(mVertices.end(), {
+        start.x, start.y, 0.0f, 0.0f, color.x, color.y, color.z, 0.0f,
+        end.x, end.y, 0.0f, 0.0f, color.x, color.y, color.z, 0.0f
+    });
+
+    ++mLineCount;
+}
+
+int LineBatch::Flush()
+{
+    if (mLineCount == 0) return 0;
+
+    mShader->SetActive();
+    GLStateCache::BindVertexArray(mVertexArray);
+
+    // Orphan the old storage so we don't wait on draws still reading it
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, mMaxLines * 2 * FLOATS_PER_VERTEX * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mVertices.size() * sizeof(float), mVertices.data());
+
+    glDrawArrays(GL_LINES, 0, mLineCount * 2);
+
+    mVertices.clear();
+    mLineCount = 0;
+
+    return 1;
+}
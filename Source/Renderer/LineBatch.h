@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include "../Math.h"
+
+// Collects every debug line of the frame into one streaming vertex buffer, drawn with a single
+// GL_LINES call. Uses the sprite shader's vertex layout with the texture factor at 0
+class LineBatch
+{
+public:
+    LineBatch(class Shader* shader, int maxLines = 16384);
+    ~LineBatch();
+
+    // Positions already in world space minus the camera
+    void AddLine(const Vector2& start, const Vector2& end, const Vector3& color);
+
+    // Draws every pending line and returns how many draw calls it took (0 or 1)
+    int Flush();
+
+    bool IsEmpty() const { return mLineCount == 0; }
+    bool IsFull() const { return mLineCount >= mMaxLines; }
+
+private:
+    // x, y, u, v, r, g, b, texture factor
+    static constexpr int FLOATS_PER_VERTEX = 8;
+
+    class Shader* mShader;
+    int mMaxLines;
+    int mLineCount;
+
+    std::vector<float> mVertices;
+
+    unsigned int mVertexArray;
+    unsigned int mVertexBuffer;
+};
@@ -0,0 +1,117 @@
+#include "ParticleBatch.h"
+#include <GL/glew.h>
+#include "GLStateCache.h"
+
+ParticleBatch::ParticleBatch(int maxParticles)
+    : mMaxParticles(maxParticles)
+    , mCount(0)
+    , mVertexArray(0)
+    , mQuadBuffer(0)
+    , mIndexBuffer(0)
+    , mInstanceBuffer(0)
+{
+    mInstances.reserve(static_cast<size_t>(maxParticles) * FLOATS_PER_INSTANCE);
+
+    // Same corners and UVs as the sprite quad from Renderer::CreateSpriteVerts
+    float quad[] = {
+        -0.5f, 0.5f, 0.0f, 1.0f,
+        0.5f, 0.5f, 1.0f, 1.0f,
+        0.5f, -0.5f, 1.0f, 0.0f,
+        -0.5f, -0.5f, 0.0f, 0.0f};
+
+    unsigned int indices[] = {
+        0, 1, 2,
+        2, 3, 0};
+
+    const size_t INSTANCE_SIZE = FLOATS_PER_INSTANCE * sizeof(float);
+
+    glGenVertexArrays(1, &mVertexArray);
+    GLStateCache::BindVertexArray(mVertexArray);
+
+    glGenBuffers(1, &mQuadBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mQuadBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // Per instance attributes advance once per quad instead of once per vertex
+    glGenBuffers(1, &mInstanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, maxParticles * INSTANCE_SIZE, nullptr, GL_STREAM_DRAW);
+
+    // Position and rotation
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, (GLsizei)INSTANCE_SIZE, (void*)0);
+    glVertexAttribDivisor(2, 1);
+
+    // Size
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, (GLsizei)INSTANCE_SIZE, (void*)(3 * sizeof(float)));
+    glVertexAttribDivisor(3, 1);
+
+    // UV rect
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, (GLsizei)INSTANCE_SIZE, (void*)(5 * sizeof(float)));
+    glVertexAttribDivisor(4, 1);
+
+    // Color and texture factor
+    glEnableVertexAttribArray(5);
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, (GLsizei)INSTANCE_SIZE, (void*)(9 * sizeof(float)));
+    glVertexAttribDivisor(5, 1);
+
+    GLStateCache::BindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+ParticleBatch::~ParticleBatch()
+{
+    glDeleteBuffers(1, &mQuadBuffer);
+    glDeleteBuffers(1, &mIndexBuffer);
+    glDeleteBuffers(1, &mInstanceBuffer);
+    GLStateCache::ForgetVertexArray(mVertexArray);
+    glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void ParticleBatch::AddParticle(const Vector2& position, float rotation, const Vector2& size, const Vector4& texRect,
+                                const Vector3& color, float textureFactor)
+{
+    if (mCount >= mMaxParticles) return;
+
+    mInstances.insert(mInstances.end(), {
+        position.x, position.y, rotation,
+        size.x, size.y,
+        texRect.x, texRect.y, texRect.z, texRect.w,
+        color.x, color.y, color.z, textureFactor
+    });
+
+    ++mCount;
+}
+
+void ParticleBatch::Clear()
+{
+    mInstances.clear();
+    mCount = 0;
+}
+
+void ParticleBatch::Draw()
+{
+    if (mCount == 0) return;
+
+    GLStateCache::BindVertexArray(mVertexArray);
+
+    // Orphan the old storage so we don't wait on draws still reading it
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, mMaxParticles * FLOATS_PER_INSTANCE * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mInstances.size() * sizeof(float), mInstances.data());
+
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, mCount);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include "../Math.h"
+
+// Instance buffer for one particle system. Every particle is the same unit quad, so only
+// its position, rotation, size, UV rect and color are streamed, and the whole system is
+// drawn with a single instanced call
+class ParticleBatch
+{
+public:
+    ParticleBatch(int maxParticles);
+    ~ParticleBatch();
+
+    // A negative size flips the quad on that axis
+    void AddParticle(const Vector2& position, float rotation, const Vector2& size, const Vector4& texRect,
+                     const Vector3& color, float textureFactor);
+    void Clear();
+
+    // Uploads the instances and draws them with whatever shader and texture are active
+    void Draw();
+
+    int GetCount() const { return mCount; }
+    bool IsEmpty() const { return mCount == 0; }
+
+private:
+    // x, y, rotation, width, height, u, v, uv width, uv height, r, g, b, texture factor
+    static constexpr int FLOATS_PER_INSTANCE = 13;
+
+    int mMaxParticles;
+    int mCount;
+
+    std::vector<float> mInstances;
+
+    unsigned int mVertexArray;
+    unsigned int mQuadBuffer;
+    unsigned int mIndexBuffer;
+    unsigned int mInstanceBuffer;
+};
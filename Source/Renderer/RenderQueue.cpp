@@ -0,0 +1,44 @@
+#include "RenderQueue.h"
+#include "../Math.h"
+
+uint64_t RenderQueue::MakeKey(RenderLayer layer, int drawOrder, unsigned int textureID, float depth)
+{
+    // Signed values are biased so negative ones still sort first
+    uint64_t order = static_cast<uint64_t>(Math::Clamp(drawOrder + 0x8000, 0, 0xFFFF));
+    uint64_t texture = static_cast<uint64_t>(textureID & 0xFFFFFF);
+    uint64_t depthBits = static_cast<uint64_t>(Math::Clamp(static_cast<int>(depth) + 0x8000, 0, 0xFFFF));
+
+    return (static_cast<uint64_t>(layer) << 56) | (order << 40) | (texture << 16) | depthBits;
+}
+
+void RenderQueue::Sort()
+{
+    size_t count = mCommands.size();
+    if (count < 2) return;
+
+    mScratch.resize(count);
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t histogram[256] = {};
+        for (const auto& command : mCommands)
+            ++histogram[(command.key >> shift) & 0xFF];
+
+        // Every key has the same byte here, the pass wouldn't move anything
+        if (histogram[(mCommands[0].key >> shift) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        // Stable scatter, so earlier passes keep ordering the lower bytes
+        for (const auto& command : mCommands)
+            mScratch[histogram[(command.key >> shift) & 0xFF]++] = command;
+
+        mCommands.swap(mScratch);
+    }
+}
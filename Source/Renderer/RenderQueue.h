@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Coarse layers above the draw order, drawn back to front
+enum class RenderLayer : uint8_t
+{
+    Background,
+    World,
+    Foreground
+};
+
+struct RenderCommand
+{
+    uint64_t key;
+    class DrawComponent* drawable;
+};
+
+// Per-frame list of draw commands ordered by a 64-bit key. From the most significant bits:
+// layer (8) | draw order (16) | texture ID (24) | Y-depth (16)
+// The draw order keeps the authored layering, and inside one draw order sprites sharing a
+// texture end up next to each other so the sprite batch can draw them in one call
+class RenderQueue
+{
+public:
+    static uint64_t MakeKey(RenderLayer layer, int drawOrder, unsigned int textureID, float depth);
+
+    void Clear() { mCommands.clear(); }
+    void Push(uint64_t key, class DrawComponent* drawable) { mCommands.push_back(RenderCommand{key, drawable}); }
+
+    // LSD radix sort, one pass per key byte. Bytes every key shares are skipped
+    void Sort();
+
+    const std::vector<RenderCommand>& GetCommands() const { return mCommands; }
+
+private:
+    std::vector<RenderCommand> mCommands;
+    std::vector<RenderCommand> mScratch;
+};
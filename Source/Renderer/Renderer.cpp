@@ -3,15 +3,33 @@
 #include "Shader.h"
 #include "VertexArray.h"
 #include "Texture.h"
+#include "SpriteBatch.h"
+#include "ParticleBatch.h"
+#include "LineBatch.h"
+#include "TextureAtlas.h"
+#include "TextureStreamer.h"
+#include "GLStateCache.h"
 #include "../Game.h"
 #include "../GameConstants.h"
 #include "../UI/UIElement.h"
 
 Renderer::Renderer(SDL_Window *window)
     : mBaseShader(nullptr),
+    mSpriteVerts(nullptr),
+    mSpriteShader(nullptr),
+    mSpriteBatch(nullptr),
+    mLineBatch(nullptr),
+    mTextShader(nullptr),
+    mTextBatch(nullptr),
+    mParticleShader(nullptr),
+    mDrawCalls(0),
+    mLastFrameDrawCalls(0),
     mWindow(window),
     mContext(nullptr),
     mOrthoProjection(Matrix4::Identity),
+    mTextureAtlas(nullptr),
+    mTextureStreamer(nullptr),
+    mPlaceholderTexture(nullptr),
     mScreenWidth(854.0f),
     mScreenHeight(480.0f)
 {
@@ -53,6 +71,9 @@ bool Renderer::Initialize(float width, float height)
         return false;
     }
 
+    // Fresh context, everything is back to the GL defaults
+    GLStateCache::Reset();
+
     // Make sure we can create/compile shaders
     if (!LoadShaders())
     {
@@ -62,19 +83,41 @@ bool Renderer::Initialize(float width, float height)
 
     // Create quad for drawing sprites
     CreateSpriteVerts();
+    mSpriteBatch = new SpriteBatch(mSpriteShader);
+    mLineBatch = new LineBatch(mSpriteShader);
+    mTextBatch = new SpriteBatch(mTextShader);
+
+    // Loaded up front since every streamed texture shows it until its own pixels arrive
+    const std::string placeholderPath = "../Assets/Sprites/NoTexture/NoTexture.png";
+    mPlaceholderTexture = new Texture();
+    mPlaceholderTexture->Load(placeholderPath);
+    mTextures.emplace(placeholderPath, mPlaceholderTexture);
+    mTextureStreamer = new TextureStreamer();
 
     // Set the clear color to light grey
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     // Enable alpha blending on textures
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Create orthografic projection matrix
     mOrthoProjection = Matrix4::CreateOrtho(0.0f, width, height, 0.0f, -1.0f, 1.0f);
-    mBaseShader->SetMatrixUniform("uOrthoProj", mOrthoProjection);
+    mBaseShader->SetMatrixUniform(ShaderUniform::OrthoProj, mOrthoProjection);
+
+    mBaseShader->SetIntegerUniform(ShaderUniform::Texture, 0);
+
+    mSpriteShader->SetActive();
+    mSpriteShader->SetMatrixUniform(ShaderUniform::OrthoProj, mOrthoProjection);
+    mSpriteShader->SetIntegerUniform(ShaderUniform::Texture, 0);
+
+    mParticleShader->SetActive();
+    mParticleShader->SetMatrixUniform(ShaderUniform::OrthoProj, mOrthoProjection);
+    mParticleShader->SetIntegerUniform(ShaderUniform::Texture, 0);
+
+    mTextShader->SetActive();
+    mTextShader->SetMatrixUniform(ShaderUniform::OrthoProj, mOrthoProjection);
+    mTextShader->SetIntegerUniform(ShaderUniform::Texture, 0);
 
-    mBaseShader->SetIntegerUniform("uTexture", 0);
     // Activate shader
     mBaseShader->SetActive();
 
@@ -98,6 +141,10 @@ void Renderer::RemoveUIElement(UIElement *comp)
 
 void Renderer::Shutdown()
 {
+    // Stop streaming before the textures it writes into go away
+    delete mTextureStreamer;
+    mTextureStreamer = nullptr;
+
     // Destroy textures
     for (auto i : mTextures)
     {
@@ -106,6 +153,9 @@ void Renderer::Shutdown()
     }
     mTextures.clear();
 
+    delete mTextureAtlas;
+    mTextureAtlas = nullptr;
+
     // Destroy fonts
     for (auto i : mFonts)
     {
@@ -114,6 +164,24 @@ void Renderer::Shutdown()
     }
     mFonts.clear();
 
+    delete mSpriteBatch;
+    mSpriteBatch = nullptr;
+
+    delete mLineBatch;
+    mLineBatch = nullptr;
+
+    delete mTextBatch;
+    mTextBatch = nullptr;
+
+    mSpriteShader->Unload();
+    delete mSpriteShader;
+
+    mParticleShader->Unload();
+    delete mParticleShader;
+
+    mTextShader->Unload();
+    delete mTextShader;
+
     mBaseShader->Unload();
     delete mBaseShader;
 
@@ -125,15 +193,22 @@ void Renderer::Clear()
 {
     // Clear the color buffer
     glClear(GL_COLOR_BUFFER_BIT);
+
+    // Start of the frame, upload whatever finished decoding since the last one
+    if (mTextureStreamer->Upload(GameConstants::TEXTURE_UPLOAD_BUDGET_MS) > 0)
+        EvictTextures(GameConstants::TEXTURE_MEMORY_BUDGET);
 }
 
 void Renderer::Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2 &cameraPos, VertexArray *vertices,
                     const Vector3 &color, Texture *texture, const Vector4 &textureRect, float textureFactor)
 {
-    mBaseShader->SetMatrixUniform("uWorldTransform", modelMatrix);
-    mBaseShader->SetVectorUniform("uColor", color);
-    mBaseShader->SetVectorUniform("uTexRect", textureRect);
-    mBaseShader->SetVectorUniform("uCameraPos", cameraPos);
+    // Anything drawn outside the batch has to land on top of the sprites queued before it
+    FlushSprites();
+
+    mBaseShader->SetMatrixUniform(ShaderUniform::WorldTransform, modelMatrix);
+    mBaseShader->SetVectorUniform(ShaderUniform::Color, color);
+    mBaseShader->SetVectorUniform(ShaderUniform::TexRect, textureRect);
+    mBaseShader->SetVectorUniform(ShaderUniform::CameraPos, cameraPos);
 
     if (vertices)
     {
@@ -143,11 +218,11 @@ void Renderer::Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2
     if (texture)
     {
         texture->SetActive();
-        mBaseShader->SetFloatUniform("uTextureFactor", textureFactor);
+        mBaseShader->SetFloatUniform(ShaderUniform::TextureFactor, textureFactor);
     }
     else
     {
-        mBaseShader->SetFloatUniform("uTextureFactor", 0.0f);
+        mBaseShader->SetFloatUniform(ShaderUniform::TextureFactor, 0.0f);
     }
 
     if (mode == RendererMode::LINES)
@@ -158,30 +233,113 @@ void Renderer::Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2
     {
         glDrawElements(GL_TRIANGLES, vertices->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
     }
+
+    ++mDrawCalls;
+}
+
+void Renderer::FlushSprites()
+{
+    if (mSpriteBatch->IsEmpty()) return;
+
+    mDrawCalls += mSpriteBatch->Flush();
+
+    // The batch switches programs, everything else expects the base shader
+    mBaseShader->SetActive();
+}
+
+void Renderer::FlushLines()
+{
+    if (mLineBatch->IsEmpty()) return;
+
+    // Lines go over everything drawn before them
+    FlushSprites();
+    mDrawCalls += mLineBatch->Flush();
+
+    mBaseShader->SetActive();
+}
+
+void Renderer::AddTextQuad(const Vector2 corners[4], const Vector2 uvs[4], const Vector3 &color, Texture *atlas)
+{
+    if (mTextBatch->IsFull()) FlushText();
+    mTextBatch->AddQuad(corners, uvs, color, 1.0f, atlas);
+}
+
+void Renderer::FlushText()
+{
+    if (mTextBatch->IsEmpty()) return;
+
+    // UI draw calls are not counted with the world ones
+    mTextBatch->Flush();
+
+    mBaseShader->SetActive();
+    mSpriteVerts->SetActive();
+}
+
+void Renderer::AddSpriteQuad(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
+                             Texture *texture, const Vector4 &textureRect, const Vector2 &cameraPos,
+                             bool flipH, bool flipV, float textureFactor)
+{
+    if (mSpriteBatch->IsFull()) FlushSprites();
+
+    // Same corners and UVs as the sprite quad from CreateSpriteVerts
+    static const Vector2 localCorners[4] = {
+        Vector2(-0.5f, 0.5f), Vector2(0.5f, 0.5f), Vector2(0.5f, -0.5f), Vector2(-0.5f, -0.5f)};
+    static const Vector2 localUVs[4] = {
+        Vector2(0.0f, 1.0f), Vector2(1.0f, 1.0f), Vector2(1.0f, 0.0f), Vector2(0.0f, 0.0f)};
+
+    float scaleX = size.x * (flipH ? -1.0f : 1.0f);
+    float scaleY = size.y * (flipV ? -1.0f : 1.0f);
+    float cosAngle = Math::Cos(rotation);
+    float sinAngle = Math::Sin(rotation);
+
+    // Scale, rotate, translate, then the camera offset the base shader applied
+    Vector2 corners[4];
+    Vector2 uvs[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        float x = localCorners[i].x * scaleX;
+        float y = localCorners[i].y * scaleY;
+        corners[i] = Vector2(x * cosAngle - y * sinAngle + position.x - cameraPos.x,
+                             x * sinAngle + y * cosAngle + position.y - cameraPos.y);
+
+        uvs[i] = Vector2(localUVs[i].x * textureRect.z + textureRect.x,
+                         localUVs[i].y * textureRect.w + textureRect.y);
+    }
+
+    mSpriteBatch->AddQuad(corners, uvs, color, texture ? textureFactor : 0.0f, texture);
 }
 
 void Renderer::DrawRect(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
                         const Vector2 &cameraPos, RendererMode mode)
 {
-    Matrix4 model = Matrix4::CreateScale(Vector3(size.x, size.y, 1.0f)) *
-                    Matrix4::CreateRotationZ(rotation) *
-                    Matrix4::CreateTranslation(Vector3(position.x, position.y, 0.0f));
+    // Filled rects are just untextured sprites
+    if (mode == RendererMode::TRIANGLES)
+    {
+        AddSpriteQuad(position, size, rotation, color, nullptr, Vector4::UnitRect, cameraPos, false, false, 0.0f);
+        return;
+    }
 
-    Draw(mode, model, cameraPos, mSpriteVerts, color);
+    // Outlines are the same corners the sprite quad uses, joined as lines
+    Vector2 extents = size * 0.5f;
+    float cosAngle = Math::Cos(rotation);
+    float sinAngle = Math::Sin(rotation);
+    Vector2 corners[4] = {
+        Vector2(-extents.x, extents.y), Vector2(extents.x, extents.y),
+        Vector2(extents.x, -extents.y), Vector2(-extents.x, -extents.y)};
+
+    for (auto &corner : corners)
+        corner = Vector2(corner.x * cosAngle - corner.y * sinAngle + position.x,
+                         corner.x * sinAngle + corner.y * cosAngle + position.y);
+
+    for (int i = 0; i < 4; ++i)
+        DrawLine(corners[i], corners[(i + 1) % 4], color, cameraPos);
 }
 
 void Renderer::DrawTexture(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
                            Texture *texture, const Vector4 &textureRect, const Vector2 &cameraPos, bool flipH,
                            bool flipV, float textureFactor)
 {
-    float flipFactorH = flipH ? -1.0f : 1.0f;
-    float flipFactorV = flipV ? -1.0f : 1.0f;
-
-    Matrix4 model = Matrix4::CreateScale(Vector3(size.x * flipFactorH, size.y * flipFactorV, 1.0f)) *
-                    Matrix4::CreateRotationZ(rotation) *
-                    Matrix4::CreateTranslation(Vector3(position.x, position.y, 0.0f));
-
-    Draw(RendererMode::TRIANGLES, model, cameraPos, mSpriteVerts, color, texture, textureRect, textureFactor);
+    AddSpriteQuad(position, size, rotation, color, texture, textureRect, cameraPos, flipH, flipV, textureFactor);
 }
 
 void Renderer::DrawGeometry(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
@@ -194,26 +352,47 @@ void Renderer::DrawGeometry(const Vector2 &position, const Vector2 &size, float
     Draw(mode, model, cameraPos, vertexArray, color);
 }
 
+void Renderer::DrawMesh(VertexArray *mesh, Texture *texture, const Vector2 &cameraPos)
+{
+    Draw(RendererMode::TRIANGLES, Matrix4::Identity, cameraPos, mesh, Vector3(1.0f, 1.0f, 1.0f), texture);
+}
+
+void Renderer::DrawParticles(ParticleBatch *batch, Texture *texture, const Vector2 &cameraPos)
+{
+    if (batch->IsEmpty()) return;
+
+    // Particles drawn now have to land on top of the sprites queued before them
+    FlushSprites();
+
+    mParticleShader->SetActive();
+    mParticleShader->SetVectorUniform(ShaderUniform::CameraPos, cameraPos);
+    if (texture) texture->SetActive();
+
+    batch->Draw();
+    ++mDrawCalls;
+
+    mBaseShader->SetActive();
+}
+
+void Renderer::DrawLine(const Vector2 &start, const Vector2 &end, const Vector3 &color, const Vector2 &cameraPos)
+{
+    if (mLineBatch->IsFull()) FlushLines();
+    mLineBatch->AddLine(start - cameraPos, end - cameraPos, color);
+}
+
 void Renderer::DrawCircle(const Vector2 &center, float radius, const Vector3 &color,
                             const Vector2 &cameraPos)
 {
-    int numVerts = 64;
-	float internalAngle = Math::ToRadians(360 / (float)numVerts);
-	float verts[numVerts * 4]; // 4 floats per vertex: x, y, u, v
-	unsigned int indices[numVerts];
-	for (int i = 0; i < numVerts; i++)
-	{
-		verts[i * 4 + 0] = radius * cos(internalAngle * i);  // x
-		verts[i * 4 + 1] = radius * sin(internalAngle * i);  // y
-		verts[i * 4 + 2] = 0.0f;  // u (unused)
-		verts[i * 4 + 3] = 0.0f;  // v (unused)
-	}
-	for (int i = 0; i < numVerts; i++) indices[i] = i;
-
-	VertexArray circleVerts(verts, numVerts, indices, numVerts);
-    Matrix4 model = Matrix4::CreateTranslation(Vector3(center.x, center.y, 0.0f));
-    
-    Draw(RendererMode::LINES, model, cameraPos, &circleVerts, color);
+    const int numSegments = 64;
+    float internalAngle = Math::TwoPi / numSegments;
+
+    Vector2 previous = center + Vector2(radius, 0.0f);
+    for (int i = 1; i <= numSegments; i++)
+    {
+        Vector2 next = center + Vector2(radius * Math::Cos(internalAngle * i), radius * Math::Sin(internalAngle * i));
+        DrawLine(previous, next, color, cameraPos);
+        previous = next;
+    }
 }
 
 void Renderer::DrawPolygon(const std::vector<Vector2> &points, const Vector3 &color, const Vector2 &offset,
@@ -222,34 +401,31 @@ void Renderer::DrawPolygon(const std::vector<Vector2> &points, const Vector3 &co
     size_t numVerts = points.size();
     if (numVerts < 2) return;
 
-    float verts[numVerts * 4]; // 4 floats per vertex: x, y, u, v
-    unsigned int indices[numVerts];
-
     for (size_t i = 0; i < numVerts; i++)
-    {
-        verts[i * 4 + 0] = points[i].x + offset.x;  // x
-        verts[i * 4 + 1] = points[i].y + offset.y;  // y
-        verts[i * 4 + 2] = 0.0f;                     // u (unused)
-        verts[i * 4 + 3] = 0.0f;                     // v (unused)
-        indices[i] = static_cast<unsigned int>(i);
-    }
-
-    VertexArray polygonVerts(verts, static_cast<unsigned int>(numVerts), indices, static_cast<unsigned int>(numVerts));
-    Matrix4 model = Matrix4::Identity;
-
-    Draw(RendererMode::LINES, model, cameraPos, &polygonVerts, color);
+        DrawLine(points[i] + offset, points[(i + 1) % numVerts] + offset, color, cameraPos);
 }
 
 void Renderer::DrawAllUI() {
+    FlushSprites();
+    FlushLines();
     mSpriteVerts->SetActive();
 
     for (auto ui : mUIComps) {
         ui->Draw(mBaseShader);
     }
+
+    FlushText();
 }
 
 void Renderer::Present()
 {
+    FlushSprites();
+    FlushLines();
+
+    mLastFrameDrawCalls = mDrawCalls;
+    mDrawCalls = 0;
+    GLStateCache::EndFrame();
+
     // Swap the buffers
     SDL_GL_SwapWindow(mWindow);
 }
@@ -263,6 +439,27 @@ bool Renderer::LoadShaders()
         return false;
     }
 
+    // Create batched sprite shader
+    mSpriteShader = new Shader();
+    if (!mSpriteShader->Load("../Shaders/Sprite"))
+    {
+        return false;
+    }
+
+    // Create text shader
+    mTextShader = new Shader();
+    if (!mTextShader->Load("../Shaders/Text"))
+    {
+        return false;
+    }
+
+    // Create instanced particle shader
+    mParticleShader = new Shader();
+    if (!mParticleShader->Load("../Shaders/Particle"))
+    {
+        return false;
+    }
+
     mBaseShader->SetActive();
 
     return true;
@@ -283,29 +480,93 @@ void Renderer::CreateSpriteVerts()
     mSpriteVerts = new VertexArray(verts, 4, indices, 6);
 }
 
+void Renderer::BuildTextureAtlas(const std::vector<std::string> &folders)
+{
+    std::vector<std::string> imagePaths;
+    for (const auto &folder : folders)
+        TextureAtlas::CollectImages(folder, imagePaths);
+
+    delete mTextureAtlas;
+    mTextureAtlas = new TextureAtlas();
+    mTextureAtlas->Build(imagePaths);
+
+    SDL_Log("[BUILD] Packed %d images into %d atlas pages", mTextureAtlas->GetImageCount(), mTextureAtlas->GetPageCount());
+}
+
+Texture *Renderer::GetTextureRegion(const std::string &fileName, Vector4 &outRect)
+{
+    if (mTextureAtlas)
+    {
+        if (Texture *page = mTextureAtlas->FindRegion(fileName, outRect))
+            return page;
+    }
+
+    outRect = Vector4::UnitRect;
+    return GetTexture(fileName);
+}
+
 Texture *Renderer::GetTexture(const std::string &fileName)
 {
-    Texture *tex = nullptr;
     auto iter = mTextures.find(fileName);
     if (iter != mTextures.end())
     {
-        tex = iter->second;
+        return iter->second;
     }
-    else
+
+    // Hand out the placeholder now, the streamer swaps the real pixels in once decoded
+    Texture *tex = new Texture();
+    tex->SetPlaceholder(mPlaceholderTexture);
+    mTextures.emplace(fileName, tex);
+    mTextureStreamer->Request(tex, fileName);
+    return tex;
+}
+
+int Renderer::GetPendingTextures() const
+{
+    return mTextureStreamer ? mTextureStreamer->GetPendingCount() : 0;
+}
+
+size_t Renderer::GetResidentTextureBytes() const
+{
+    size_t bytes = mTextureAtlas ? mTextureAtlas->GetResidentBytes() : 0;
+    for (const auto &[fileName, tex] : mTextures)
+        bytes += tex->GetResidentBytes();
+    return bytes;
+}
+
+void Renderer::ReleaseUnusedTextures()
+{
+    EvictTextures(0);
+}
+
+void Renderer::EvictTextures(size_t budgetBytes)
+{
+    size_t resident = GetResidentTextureBytes();
+    if (resident <= budgetBytes) return;
+
+    // Textures still streaming are skipped, the worker holds on to them until they upload
+    std::vector<decltype(mTextures)::iterator> candidates;
+    for (auto iter = mTextures.begin(); iter != mTextures.end(); ++iter)
     {
-        tex = new Texture();
-        if (tex->Load(fileName))
-        {
-            mTextures.emplace(fileName, tex);
-            return tex;
-        }
-        else
-        {
-            delete tex;
-            return nullptr;
-        }
+        Texture *tex = iter->second;
+        if (tex != mPlaceholderTexture && tex->GetRefCount() == 0 && !tex->IsPlaceholder())
+            candidates.push_back(iter);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b)
+    {
+        return a->second->GetReleaseOrder() < b->second->GetReleaseOrder();
+    });
+
+    for (auto iter : candidates)
+    {
+        if (resident <= budgetBytes) break;
+
+        resident -= iter->second->GetResidentBytes();
+        iter->second->Unload();
+        delete iter->second;
+        mTextures.erase(iter);
     }
-    return tex;
 }
 
 Font* Renderer::GetFont(const std::string& fileName)
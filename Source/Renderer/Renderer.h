@@ -41,31 +41,71 @@ public:
     void DrawGeometry(const Vector2 &position, const Vector2 &size,  float rotation,
                       const Vector3 &color, const Vector2 &cameraPos, VertexArray *vertexArray, RendererMode mode);
 
+    // Lines, circles, polygons and outlined rects all go into the debug line batch
+    void DrawLine(const Vector2 &start, const Vector2 &end, const Vector3 &color,
+                  const Vector2 &cameraPos = Vector2::Zero);
+
     void DrawCircle(const Vector2 &center, float radius, const Vector3 &color,
                     const Vector2 &cameraPos = Vector2::Zero);
 
     void DrawPolygon(const std::vector<Vector2> &points, const Vector3 &color, const Vector2 &offset = Vector2::Zero,
                      const Vector2 &cameraPos = Vector2::Zero);
 
+    // Draws prebuilt world space geometry, like the baked tile chunks
+    void DrawMesh(VertexArray *mesh, Texture *texture, const Vector2 &cameraPos);
+
+    // Draws every particle in the batch with one instanced call
+    void DrawParticles(class ParticleBatch *batch, Texture *texture, const Vector2 &cameraPos);
+
     void DrawAllUI();
 
+    // Draws everything the sprite batch has collected so far
+    void FlushSprites();
+    // Draws every line collected this frame in one call, on top of the sprites
+    void FlushLines();
+
+    // Queues a glyph quad from a font's glyph atlas, corners in screen space
+    void AddTextQuad(const Vector2 corners[4], const Vector2 uvs[4], const Vector3 &color, Texture *atlas);
+    // Draws the queued glyphs and restores the state the other UI elements draw with
+    void FlushText();
+
     void UpdateViewport(int windowWidth, int windowHeight);
 
+    // Packs every image found under the folders into shared atlas pages
+    void BuildTextureAtlas(const std::vector<std::string>& folders);
+
     void Clear();
     void Present();
 
     // Getters
     class Texture* GetTexture(const std::string& fileName);
+    // Images not streamed in yet
+    int GetPendingTextures() const;
+    // GL memory held by loaded textures and atlas pages
+    size_t GetResidentTextureBytes() const;
+    // Evicts every texture no handle refers to anymore
+    void ReleaseUnusedTextures();
+    // Page and rect of a packed image, or the image's own texture with the unit rect
+    class Texture* GetTextureRegion(const std::string& fileName, Vector4& outRect);
 	class Shader* GetBaseShader() const { return mBaseShader; }
     class Font* GetFont(const std::string& fileName);
     float GetScreenWidth() { return mScreenWidth; }
     float GetScreenHeight() { return mScreenHeight; }
+    // Draw calls issued through the renderer during the last presented frame (UI not included)
+    int GetDrawCalls() const { return mLastFrameDrawCalls; }
 
 private:
     void Draw(RendererMode mode, const Matrix4 &modelMatrix, const Vector2 &cameraPos, VertexArray *vertices,
               const Vector3 &color,  Texture *texture = nullptr, const Vector4 &textureRect = Vector4::UnitRect, float textureFactor = 1.0f);
 
+    // Queues a quad with the same transform DrawTexture used to build as a model matrix
+    void AddSpriteQuad(const Vector2 &position, const Vector2 &size, float rotation, const Vector3 &color,
+                       Texture *texture, const Vector4 &textureRect, const Vector2 &cameraPos,
+                       bool flipH, bool flipV, float textureFactor);
+
 	bool LoadShaders();
+    // Evicts unreferenced textures, least recently released first, until resident memory fits the budget
+    void EvictTextures(size_t budgetBytes);
     void CreateSpriteVerts();
 
 	// Game
@@ -77,6 +117,23 @@ private:
     // Sprite vertex array
     class VertexArray *mSpriteVerts;
 
+    // Batched sprites, drawn with their own shader
+    class Shader* mSpriteShader;
+    class SpriteBatch* mSpriteBatch;
+
+    // Debug lines, drawn with the sprite shader
+    class LineBatch* mLineBatch;
+
+    // Glyph quads for UI text, tinted per vertex
+    class Shader* mTextShader;
+    class SpriteBatch* mTextBatch;
+
+    // Instanced particle shader
+    class Shader* mParticleShader;
+
+    int mDrawCalls;
+    int mLastFrameDrawCalls;
+
 	// Window
 	SDL_Window* mWindow;
 
@@ -86,6 +143,13 @@ private:
 	// Ortho projection for 2D shaders
 	Matrix4 mOrthoProjection;
 
+    // Small images packed together, looked up before loading a texture of their own
+    class TextureAtlas* mTextureAtlas;
+
+    // Decodes textures in the background, shown as the placeholder until uploaded
+    class TextureStreamer* mTextureStreamer;
+    class Texture* mPlaceholderTexture;
+
     // Map of textures loaded
     std::unordered_map<std::string, class Texture*> mTextures;
     // Map of fonts loaded
@@ -1,13 +1,33 @@
 #include <SDL.h>
 #include "Shader.h"
+#include "GLStateCache.h"
 #include <fstream>
 #include <sstream>
 
+namespace
+{
+    // Indexed by ShaderUniform
+    const char* UNIFORM_NAMES[] = {
+        "uWorldTransform",
+        "uOrthoProj",
+        "uColor",
+        "uCameraPos",
+        "uTexRect",
+        "uTexture",
+        "uTextureFactor",
+        "uBaseColor"
+    };
+
+    static_assert(sizeof(UNIFORM_NAMES) / sizeof(UNIFORM_NAMES[0]) == static_cast<int>(ShaderUniform::Count),
+                  "Every ShaderUniform needs a name");
+}
+
 Shader::Shader()
 : mVertexShader(0)
 , mFragShader(0)
 , mShaderProgram(0)
 {
+	for (auto& location : mKnownLocations) location = -1;
 }
 
 Shader::~Shader()
@@ -31,12 +51,19 @@ bool Shader::Load(const std::string& name)
 	glLinkProgram(mShaderProgram);
 
 	// Verify that the program linked successfully
-	return IsValidProgram();
+	if (!IsValidProgram())
+	{
+		return false;
+	}
+
+	CacheUniformLocations();
+	return true;
 }
 
 void Shader::Unload()
 {
 	// Delete the program/shaders
+	GLStateCache::ForgetProgram(mShaderProgram);
 	glDeleteProgram(mShaderProgram);
 	glDeleteShader(mVertexShader);
 	glDeleteShader(mFragShader);
@@ -44,63 +71,110 @@ void Shader::Unload()
 	mShaderProgram = 0;
 	mVertexShader = 0;
 	mFragShader = 0;
+
+	mUniformLocations.clear();
+	for (auto& location : mKnownLocations) location = -1;
+}
+
+void Shader::CacheUniformLocations()
+{
+	mUniformLocations.clear();
+
+	GLint count = 0;
+	glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORMS, &count);
+
+	char name[256];
+	for (GLint i = 0; i < count; ++i)
+	{
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(mShaderProgram, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+
+		// Arrays are reported as "name[0]", we only ever set them by their base name
+		std::string uniformName(name, length);
+		size_t bracket = uniformName.find('[');
+		if (bracket != std::string::npos) uniformName.resize(bracket);
+
+		mUniformLocations[uniformName] = glGetUniformLocation(mShaderProgram, name);
+	}
+
+	for (int i = 0; i < static_cast<int>(ShaderUniform::Count); ++i)
+	{
+		mKnownLocations[i] = GetUniformLocation(UNIFORM_NAMES[i]);
+	}
+}
+
+GLint Shader::GetUniformLocation(const char* name) const
+{
+	auto iter = mUniformLocations.find(name);
+	return iter != mUniformLocations.end() ? iter->second : -1;
 }
 
 void Shader::SetActive() const
 {
 	// Set this program as the active one
-	glUseProgram(mShaderProgram);
+	GLStateCache::UseProgram(mShaderProgram);
 }
 
-void Shader::SetVectorUniform(const char* name, const Vector2& vector) const
+void Shader::SetVectorUniform(ShaderUniform uniform, const Vector2& vector) const
 {
-    // Find the uniform by this name
-    GLint loc = glGetUniformLocation(mShaderProgram, name);
+    glUniform2fv(GetUniformLocation(uniform), 1, vector.GetAsFloatPtr());
+}
 
-    // Send the vector data to the uniform
-    glUniform2fv(loc, 1, vector.GetAsFloatPtr());
+void Shader::SetVectorUniform(ShaderUniform uniform, const Vector3& vector) const
+{
+    glUniform3fv(GetUniformLocation(uniform), 1, vector.GetAsFloatPtr());
 }
 
-void Shader::SetVectorUniform(const char* name, const Vector3& vector) const
+void Shader::SetVectorUniform(ShaderUniform uniform, const Vector4& vector) const
 {
-	// Find the uniform by this name
-	GLint loc = glGetUniformLocation(mShaderProgram, name);
+    glUniform4fv(GetUniformLocation(uniform), 1, vector.GetAsFloatPtr());
+}
 
-	// Send the vector data to the uniform
-	glUniform3fv(loc, 1, vector.GetAsFloatPtr());
+void Shader::SetMatrixUniform(ShaderUniform uniform, const Matrix4& matrix) const
+{
+    glUniformMatrix4fv(GetUniformLocation(uniform), 1, GL_FALSE, matrix.GetAsFloatPtr());
 }
 
-void Shader::SetVectorUniform(const char* name, const Vector4& vector) const
+void Shader::SetFloatUniform(ShaderUniform uniform, float value) const
 {
-    // Find the uniform by this name
-    GLint loc = glGetUniformLocation(mShaderProgram, name);
+    glUniform1f(GetUniformLocation(uniform), value);
+}
 
-    // Send the vector data to the uniform
-    glUniform4fv(loc, 1, vector.GetAsFloatPtr());
+void Shader::SetIntegerUniform(ShaderUniform uniform, int value) const
+{
+    glUniform1i(GetUniformLocation(uniform), value);
 }
 
-void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix) const
+void Shader::SetVectorUniform(const char* name, const Vector2& vector) const
 {
-	// Find the uniform by this name
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+    glUniform2fv(GetUniformLocation(name), 1, vector.GetAsFloatPtr());
+}
 
-    // Send the matrix data to the uniform
-	glUniformMatrix4fv(loc, 1, GL_FALSE, matrix.GetAsFloatPtr());
+void Shader::SetVectorUniform(const char* name, const Vector3& vector) const
+{
+	glUniform3fv(GetUniformLocation(name), 1, vector.GetAsFloatPtr());
 }
 
-void Shader::SetFloatUniform(const char *name, float value) const
+void Shader::SetVectorUniform(const char* name, const Vector4& vector) const
 {
-    // Find the uniform by this name
-    GLuint loc = glGetUniformLocation(mShaderProgram, name);
+    glUniform4fv(GetUniformLocation(name), 1, vector.GetAsFloatPtr());
+}
 
-    // Send the float data to the uniform
-    glUniform1f(loc, value);
+void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix) const
+{
+	glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, matrix.GetAsFloatPtr());
+}
+
+void Shader::SetFloatUniform(const char *name, float value) const
+{
+    glUniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::SetIntegerUniform(const char *name, int value) const
 {
-	GLuint uTexture = glGetUniformLocation(mShaderProgram, name);
-    glUniform1i(uTexture, 0);
+    glUniform1i(GetUniformLocation(name), value);
 }
 
 bool Shader::CompileShader(const std::string& fileName, GLenum shaderType, GLuint& outShader)
@@ -1,8 +1,23 @@
 #pragma once
 #include <GL/glew.h>
 #include <string>
+#include <unordered_map>
 #include "../Math.h"
 
+// Uniforms shared by our shaders, resolved once when the program links
+enum class ShaderUniform
+{
+    WorldTransform,
+    OrthoProj,
+    Color,
+    CameraPos,
+    TexRect,
+    Texture,
+    TextureFactor,
+    BaseColor,
+    Count
+};
+
 class Shader
 {
 public:
@@ -17,7 +32,15 @@ public:
     // Set this as the active shader program
 	void SetActive() const;
 
-    // Sets a Vector / Matrix uniform
+    // Sets a Vector / Matrix uniform through its pre-resolved location
+    void SetVectorUniform(ShaderUniform uniform, const Vector2& vector) const;
+    void SetVectorUniform(ShaderUniform uniform, const Vector3& vector) const;
+    void SetVectorUniform(ShaderUniform uniform, const Vector4& vector) const;
+    void SetMatrixUniform(ShaderUniform uniform, const Matrix4& matrix) const;
+    void SetFloatUniform(ShaderUniform uniform, float value) const;
+    void SetIntegerUniform(ShaderUniform uniform, int value) const;
+
+    // Same setters by name, looked up in the locations cached at link time
     void SetVectorUniform (const char* name, const Vector2& vector) const;
 	void SetVectorUniform (const char* name, const Vector3& vector) const;
     void SetVectorUniform (const char* name, const Vector4& vector) const;
@@ -25,6 +48,10 @@ public:
     void SetFloatUniform(const char* name, float value) const;
     void SetIntegerUniform(const char *name, int value) const;
 
+    // -1 when the uniform isn't active in this program (setting it is then a no-op)
+    GLint GetUniformLocation(const char* name) const;
+    GLint GetUniformLocation(ShaderUniform uniform) const { return mKnownLocations[static_cast<int>(uniform)]; }
+
 private:
 	// Tries to compile the specified shader
 	bool CompileShader(const std::string& fileName, GLenum shaderType, GLuint& outShader);
@@ -34,8 +61,14 @@ private:
 	// Tests whether vertex/fragment programs link
 	bool IsValidProgram() const;
 
+	// Reads every active uniform of the linked program
+	void CacheUniformLocations();
+
 	// Store the shader object IDs
 	GLuint mVertexShader;
 	GLuint mFragShader;
 	GLuint mShaderProgram;
+
+	std::unordered_map<std::string, GLint> mUniformLocations;
+	GLint mKnownLocations[static_cast<int>(ShaderUniform::Count)];
 };
@@ -0,0 +1,126 @@
+#include "SpriteBatch.h"
+#include <GL/glew.h>
+#include "Shader.h"
+#include "Texture.h"
+#include "GLStateCache.h"
+
+SpriteBatch::SpriteBatch(Shader* shader, int maxQuads)
+    : mShader(shader)
+    , mMaxQuads(maxQuads)
+    , mQuadCount(0)
+    , mVertexArray(0)
+    , mVertexBuffer(0)
+    , mIndexBuffer(0)
+{
+    mVertices.reserve(static_cast<size_t>(maxQuads) * 4 * FLOATS_PER_VERTEX);
+
+    // Every quad uses the same two triangles, so the index buffer never changes
+    std::vector<unsigned int> indices(static_cast<size_t>(maxQuads) * 6);
+    for (int i = 0; i < maxQuads; ++i)
+    {
+        unsigned int base = i * 4;
+        indices[i * 6 + 0] = base + 0;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base + 2;
+        indices[i * 6 + 4] = base + 3;
+        indices[i * 6 + 5] = base + 0;
+    }
+
+    const size_t VERTEX_SIZE = FLOATS_PER_VERTEX * sizeof(float);
+
+    glGenVertexArrays(1, &mVertexArray);
+    GLStateCache::BindVertexArray(mVertexArray);
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, maxQuads * 4 * VERTEX_SIZE, nullptr, GL_STREAM_DRAW);
+
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)0);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(2 * sizeof(float)));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(4 * sizeof(float)));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(7 * sizeof(float)));
+
+    GLStateCache::BindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteBuffers(1, &mIndexBuffer);
+    GLStateCache::ForgetVertexArray(mVertexArray);
+    glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void SpriteBatch::AddQuad(const Vector2 corners[4], const Vector2 uvs[4], const Vector3& color,
+                          float textureFactor, Texture* texture)
+{
+    if (IsFull()) return;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        mVertices.push_back(corners[i].x);
+        mVertices.push_back(corners[i].y);
+        mVertices.push_back(uvs[i].x);
+        mVertices.push_back(uvs[i].y);
+        mVertices.push_back(color.x);
+        mVertices.push_back(color.y);
+        mVertices.push_back(color.z);
+        mVertices.push_back(textureFactor);
+    }
+
+    Run* run = mRuns.empty() ? nullptr : &mRuns.back();
+    if (run && (!texture || !run->texture || run->texture == texture))
+    {
+        if (!run->texture) run->texture = texture;
+        ++run->quadCount;
+    }
+    else
+    {
+        mRuns.push_back(Run{texture, mQuadCount, 1});
+    }
+
+    ++mQuadCount;
+}
+
+int SpriteBatch::Flush()
+{
+    if (mQuadCount == 0) return 0;
+
+    mShader->SetActive();
+    GLStateCache::BindVertexArray(mVertexArray);
+
+    // Orphan the old storage so we don't wait on draws still reading it
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, mMaxQuads * 4 * FLOATS_PER_VERTEX * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, mVertices.size() * sizeof(float), mVertices.data());
+
+    for (const auto& run : mRuns)
+    {
+        if (run.texture) run.texture->SetActive();
+
+        glDrawElements(GL_TRIANGLES, run.quadCount * 6, GL_UNSIGNED_INT,
+                       (void*)(run.firstQuad * 6 * sizeof(GLuint)));
+    }
+
+    int drawCalls = static_cast<int>(mRuns.size());
+
+    mVertices.clear();
+    mRuns.clear();
+    mQuadCount = 0;
+
+    return drawCalls;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "../Math.h"
+
+// Collects quads into one streaming vertex buffer. Consecutive quads that share a texture
+// form a run, and every run is drawn with a single call when the batch is flushed.
+// Quads keep the order they were added in, so the output matches drawing them one by one
+class SpriteBatch
+{
+public:
+    SpriteBatch(class Shader* shader, int maxQuads = 4096);
+    ~SpriteBatch();
+
+    // Corners and UVs go counter-clockwise, positions already in world space minus the camera.
+    // A null texture joins any run (the texture factor is expected to be 0 then)
+    void AddQuad(const Vector2 corners[4], const Vector2 uvs[4], const Vector3& color,
+                 float textureFactor, class Texture* texture);
+
+    // Draws every pending run with the sprite shader and returns how many draw calls it took
+    int Flush();
+
+    bool IsEmpty() const { return mQuadCount == 0; }
+    bool IsFull() const { return mQuadCount >= mMaxQuads; }
+
+private:
+    struct Run
+    {
+        class Texture* texture;
+        int firstQuad;
+        int quadCount;
+    };
+
+    // x, y, u, v, r, g, b, texture factor
+    static constexpr int FLOATS_PER_VERTEX = 8;
+
+    class Shader* mShader;
+    int mMaxQuads;
+    int mQuadCount;
+
+    std::vector<float> mVertices;
+    std::vector<Run> mRuns;
+
+    unsigned int mVertexArray;
+    unsigned int mVertexBuffer;
+    unsigned int mIndexBuffer;
+};
@@ -1,15 +1,30 @@
 #include "Texture.h"
+#include "GLStateCache.h"
+#include "TextureFile.h"
 
 Texture::Texture()
     : mTextureID(0)
       , mWidth(0)
-      , mHeight(0) {
+      , mHeight(0)
+      , mIsPlaceholder(false)
+      , mRefCount(0)
+      , mReleaseOrder(0) {
 }
 
 Texture::~Texture() {
 }
 
-bool Texture::Load(const std::string &filePath) {
+bool Texture::Load(const std::string &filePath, bool allowBaked) {
+
+    if (allowBaked && TextureFile::HasBakedCopy(filePath)) {
+        TextureFile file;
+        if (file.Open(TextureFile::GetBakedPath(filePath))) {
+            mWidth = file.GetWidth();
+            mHeight = file.GetHeight();
+            Upload(GL_RGBA, file.GetPixels());
+            return true;
+        }
+    }
 
     SDL_Surface *surf = IMG_Load(filePath.c_str());
     if (!surf) {
@@ -20,17 +35,6 @@ bool Texture::Load(const std::string &filePath) {
     mWidth = surf->w;
     mHeight = surf->h;
 
-    glGenTextures(1, &mTextureID);
-    glBindTexture(GL_TEXTURE_2D, mTextureID);
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
     GLenum format = GL_RGB;
 
     if (surf->format->BytesPerPixel == 4) {
@@ -39,38 +43,88 @@ bool Texture::Load(const std::string &filePath) {
         format = GL_RGB;
     }
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, mWidth, mHeight, 0, format,GL_UNSIGNED_BYTE, surf->pixels);
+    Upload(format, surf->pixels);
 
     SDL_FreeSurface(surf);
 
     return true;
 }
 
-void Texture::CreateFromSurface(SDL_Surface* surface)
+void Texture::Upload(GLenum format, const void *pixels) {
+    glGenTextures(1, &mTextureID);
+    GLStateCache::BindTexture(0, mTextureID);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, format, mWidth, mHeight, 0, format,GL_UNSIGNED_BYTE, pixels);
+}
+
+void Texture::CreateFromSurface(SDL_Surface* surface, bool smooth)
 {
     mWidth = surface->w;
     mHeight = surface->h;
 
     // Generate a GL texture
     glGenTextures(1, &mTextureID);
-    glBindTexture(GL_TEXTURE_2D, mTextureID);
+    GLStateCache::BindTexture(0, mTextureID);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitch / 4);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE,
                  surface->pixels);
 
-    // Use linear filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (smooth) {
+        // Use linear filtering
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+}
+
+void Texture::CreateFromPixels(int width, int height, const void *pixels) {
+    // The placeholder's texture is not ours to reuse
+    if (mIsPlaceholder) {
+        mTextureID = 0;
+        mIsPlaceholder = false;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    Upload(GL_RGBA, pixels);
+}
+
+void Texture::SetPlaceholder(const Texture *placeholder) {
+    mTextureID = placeholder->GetTextureID();
+    mWidth = placeholder->GetWidth();
+    mHeight = placeholder->GetHeight();
+    mIsPlaceholder = true;
 }
 
 void Texture::Unload() {
-    glDeleteTextures(1, &mTextureID);
+    if (!mIsPlaceholder) {
+        GLStateCache::ForgetTexture(mTextureID);
+        glDeleteTextures(1, &mTextureID);
+    }
+    mIsPlaceholder = false;
     mTextureID = 0;
     mWidth = 0;
     mHeight = 0;
 }
 
+void Texture::Release() {
+    if (--mRefCount == 0) {
+        mReleaseOrder = ++sReleaseCounter;
+    }
+}
+
 void Texture::SetActive(int index) const {
-    glActiveTexture(GL_TEXTURE0 + index);
-    glBindTexture(GL_TEXTURE_2D, mTextureID);
+    GLStateCache::BindTexture(index, mTextureID);
 }
@@ -10,10 +10,19 @@ public:
 	Texture();
 	~Texture();
 
-	bool Load(const std::string& fileName);
+	// Prefers the baked .stex copy next to the image and decodes the image only without one
+	bool Load(const std::string& fileName, bool allowBaked = true);
 	void Unload();
 
-	void CreateFromSurface(struct SDL_Surface* surface);
+	// Smooth uses linear filtering, otherwise nearest with clamped edges like Load
+	void CreateFromSurface(struct SDL_Surface* surface, bool smooth = true);
+
+	// Tightly packed RGBA rows. With a pixel unpack buffer bound, pixels is an offset into it
+	void CreateFromPixels(int width, int height, const void* pixels);
+
+	// Borrows the placeholder's GL texture and size until real pixels are created
+	void SetPlaceholder(const Texture* placeholder);
+	bool IsPlaceholder() const { return mIsPlaceholder; }
 
 	void SetActive(int index = 0) const;
 
@@ -22,8 +31,27 @@ public:
 
 	unsigned int GetTextureID() const { return mTextureID; }
 
+	// GL memory this texture owns, a placeholder owns none
+	size_t GetResidentBytes() const { return mIsPlaceholder ? 0 : static_cast<size_t>(mWidth) * mHeight * 4; }
+
+	// Counted by TextureHandle, the renderer only evicts textures nobody holds
+	void AddRef() { ++mRefCount; }
+	void Release();
+	int GetRefCount() const { return mRefCount; }
+
+	// Grows every time a texture loses its last reference, oldest releases are evicted first
+	unsigned int GetReleaseOrder() const { return mReleaseOrder; }
+
 private:
+	void Upload(GLenum format, const void* pixels);
+
 	unsigned int mTextureID;
 	int mWidth;
 	int mHeight;
+	bool mIsPlaceholder;
+
+	int mRefCount;
+	unsigned int mReleaseOrder;
+
+	inline static unsigned int sReleaseCounter = 0;
 };
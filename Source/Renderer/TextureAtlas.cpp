@@ -0,0 +1,253 @@
+#include "TextureAtlas.h"
+#include "Texture.h"
+#include "../Json.h"
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+TextureAtlas::TextureAtlas(int pageSize)
+    : mPageSize(pageSize)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    Unload();
+}
+
+bool TextureAtlas::Build(const std::vector<std::string>& imagePaths)
+{
+    Unload();
+
+    struct Image
+    {
+        std::string path;
+        SDL_Surface* surface;
+    };
+
+    // Full screen art would take most of a page on its own, it is cheaper as a separate texture
+    const int maxArea = mPageSize * mPageSize / 8;
+
+    std::vector<Image> images;
+    for (const auto& path : imagePaths)
+    {
+        bool duplicate = std::any_of(images.begin(), images.end(), [&](const Image& image) { return image.path == path; });
+        if (duplicate) continue;
+
+        SDL_Surface* surface = IMG_Load(path.c_str());
+        if (!surface)
+        {
+            SDL_Log("Failed to load atlas image %s", path.c_str());
+            continue;
+        }
+
+        if (surface->w + PADDING > mPageSize || surface->h + PADDING > mPageSize || surface->w * surface->h > maxArea)
+        {
+            SDL_FreeSurface(surface);
+            continue;
+        }
+
+        images.push_back(Image{path, surface});
+    }
+
+    std::sort(images.begin(), images.end(), [](const Image& a, const Image& b)
+    {
+        return a.surface->h != b.surface->h ? a.surface->h > b.surface->h : a.surface->w > b.surface->w;
+    });
+
+    float size = static_cast<float>(mPageSize);
+    for (auto& image : images)
+    {
+        int x = 0;
+        int y = 0;
+        int pageIndex = 0;
+        while (pageIndex < static_cast<int>(mPages.size()) &&
+               !Insert(mPages[pageIndex], image.surface->w, image.surface->h, x, y))
+            ++pageIndex;
+
+        if (pageIndex == static_cast<int>(mPages.size()) &&
+            (!AddPage() || !Insert(mPages.back(), image.surface->w, image.surface->h, x, y)))
+        {
+            SDL_Log("Failed to pack %s into the texture atlas", image.path.c_str());
+            SDL_FreeSurface(image.surface);
+            continue;
+        }
+
+        // Copy the pixels as they are instead of blending them over the empty page
+        SDL_Rect dest{x, y, image.surface->w, image.surface->h};
+        SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(image.surface, nullptr, mPages[pageIndex].surface, &dest);
+
+        mRegions[image.path] = Region{pageIndex, Vector4(x / size, y / size, dest.w / size, dest.h / size)};
+        SDL_FreeSurface(image.surface);
+    }
+
+    // Pixel art, so the pages keep the nearest filtering Texture::Load uses
+    for (auto& page : mPages)
+    {
+        page.texture = new Texture();
+        page.texture->CreateFromSurface(page.surface, false);
+        SDL_FreeSurface(page.surface);
+        page.surface = nullptr;
+    }
+
+    return !mRegions.empty();
+}
+
+void TextureAtlas::Unload()
+{
+    for (auto& page : mPages)
+    {
+        if (page.surface) SDL_FreeSurface(page.surface);
+        if (page.texture)
+        {
+            page.texture->Unload();
+            delete page.texture;
+        }
+    }
+
+    mPages.clear();
+    mRegions.clear();
+}
+
+size_t TextureAtlas::GetResidentBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& page : mPages)
+        if (page.texture) bytes += page.texture->GetResidentBytes();
+    return bytes;
+}
+
+Texture* TextureAtlas::FindRegion(const std::string& fileName, Vector4& outRect) const
+{
+    auto iter = mRegions.find(fileName);
+    if (iter == mRegions.end()) return nullptr;
+
+    const Page& page = mPages[iter->second.page];
+    if (!page.texture) return nullptr;
+
+    outRect = iter->second.rect;
+    return page.texture;
+}
+
+void TextureAtlas::CollectImages(const std::string& folder, std::vector<std::string>& outPaths)
+{
+    std::error_code ec{};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{folder, ec})
+    {
+        if (!entry.is_regular_file()) continue;
+
+        std::string extension = entry.path().extension().string();
+        if (extension == ".png")
+        {
+            outPaths.push_back(entry.path().generic_string());
+        }
+        else if (extension == ".json")
+        {
+            std::ifstream file(entry.path());
+            nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+            if (!data.is_discarded() && data.contains("image") && data["image"].is_string())
+                outPaths.push_back(data["image"].get<std::string>());
+        }
+    }
+}
+
+Vector4 TextureAtlas::RemapRect(const Vector4& rect, const Vector4& region)
+{
+    return Vector4(region.x + rect.x * region.z, region.y + rect.y * region.w, rect.z * region.z, rect.w * region.w);
+}
+
+bool TextureAtlas::AddPage()
+{
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, mPageSize, mPageSize, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface)
+    {
+        SDL_Log("Failed to create texture atlas page: %s", SDL_GetError());
+        return false;
+    }
+
+    // One node spanning the whole empty page
+    mPages.push_back(Page{surface, {SkylineNode{0, 0, mPageSize}}, nullptr});
+    return true;
+}
+
+int TextureAtlas::FitAt(const Page& page, size_t index, int width, int height) const
+{
+    if (page.skyline[index].x + width > mPageSize) return -1;
+
+    // The rect rests on the highest node it spans
+    int y = page.skyline[index].y;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        if (i >= page.skyline.size()) return -1;
+
+        y = std::max(y, page.skyline[i].y);
+        if (y + height > mPageSize) return -1;
+
+        remaining -= page.skyline[i].width;
+    }
+
+    return y;
+}
+
+bool TextureAtlas::Insert(Page& page, int width, int height, int& outX, int& outY)
+{
+    width += PADDING;
+    height += PADDING;
+
+    // Bottom-left rule: the lowest resting place wins, the narrower node breaks ties
+    int bestIndex = -1;
+    int bestY = mPageSize;
+    int bestWidth = mPageSize + 1;
+    for (size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        int y = FitAt(page, i, width, height);
+        if (y < 0) continue;
+
+        if (y < bestY || (y == bestY && page.skyline[i].width < bestWidth))
+        {
+            bestIndex = static_cast<int>(i);
+            bestY = y;
+            bestWidth = page.skyline[i].width;
+        }
+    }
+
+    if (bestIndex < 0) return false;
+
+    outX = page.skyline[bestIndex].x;
+    outY = bestY;
+
+    auto& skyline = page.skyline;
+    skyline.insert(skyline.begin() + bestIndex, SkylineNode{outX, bestY + height, width});
+
+    // Trim the nodes now covered by the new one
+    for (size_t i = bestIndex + 1; i < skyline.size();)
+    {
+        const SkylineNode& previous = skyline[i - 1];
+        int overlap = previous.x + previous.width - skyline[i].x;
+        if (overlap <= 0) break;
+
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width > 0) break;
+
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours left at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+
+    return true;
+}
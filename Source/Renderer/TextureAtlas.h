@@ -0,0 +1,67 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../Math.h"
+
+struct SDL_Surface;
+
+// Packs many small images (sprite sheets, icons, HUD cards) into a few large pages so most of
+// a frame samples the same texture. Images keep their file name as key and are looked up as a
+// page plus the normalized rect they occupy on it
+class TextureAtlas
+{
+public:
+    TextureAtlas(int pageSize = 2048);
+    ~TextureAtlas();
+
+    // Skyline bottom-left packing, tallest images first. Images too large to share a page are
+    // left out and keep loading on their own
+    bool Build(const std::vector<std::string>& imagePaths);
+    void Unload();
+
+    // Returns the page holding the image and its rect on it, or nullptr if it was not packed
+    class Texture* FindRegion(const std::string& fileName, Vector4& outRect) const;
+
+    int GetPageCount() const { return static_cast<int>(mPages.size()); }
+    int GetImageCount() const { return static_cast<int>(mRegions.size()); }
+    size_t GetResidentBytes() const;
+
+    // Every image under the folder: .png files directly and the "image" of each animation .json
+    static void CollectImages(const std::string& folder, std::vector<std::string>& outPaths);
+
+    // Maps a rect relative to the original image into the rect of its region
+    static Vector4 RemapRect(const Vector4& rect, const Vector4& region);
+
+private:
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page
+    {
+        SDL_Surface* surface;
+        std::vector<SkylineNode> skyline;
+        class Texture* texture;
+    };
+
+    struct Region
+    {
+        int page;
+        Vector4 rect;
+    };
+
+    // Keeps a pixel between images so neighbours never bleed into each other
+    static constexpr int PADDING = 1;
+
+    bool AddPage();
+    bool Insert(Page& page, int width, int height, int& outX, int& outY);
+    int FitAt(const Page& page, size_t index, int width, int height) const;
+
+    int mPageSize;
+    std::vector<Page> mPages;
+    std::unordered_map<std::string, Region> mRegions;
+};
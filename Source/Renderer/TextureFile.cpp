@@ -0,0 +1,168 @@
+#include "TextureFile.h"
+#include <SDL.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+TextureFile::TextureFile()
+    : mData(nullptr)
+    , mSize(0)
+    , mWidth(0)
+    , mHeight(0)
+    , mFileHandle(nullptr)
+    , mMappingHandle(nullptr)
+{
+}
+
+TextureFile::~TextureFile()
+{
+    Close();
+}
+
+bool TextureFile::Open(const std::string& path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    mFileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(Header)))
+    {
+        Close();
+        return false;
+    }
+    mSize = static_cast<size_t>(size.QuadPart);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        Close();
+        return false;
+    }
+    mMappingHandle = mapping;
+
+    mData = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        close(file);
+        return false;
+    }
+    mSize = static_cast<size_t>(info.st_size);
+
+    // The mapping keeps its own reference to the file, the descriptor is not needed past this
+    void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    mData = (data != MAP_FAILED) ? static_cast<const unsigned char*>(data) : nullptr;
+#endif
+
+    if (!mData)
+    {
+        Close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, mData, sizeof(Header));
+    size_t expected = sizeof(Header) + static_cast<size_t>(header.width) * header.height * 4;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || mSize != expected)
+    {
+        SDL_Log("Invalid baked texture file %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    mWidth = static_cast<int>(header.width);
+    mHeight = static_cast<int>(header.height);
+    return true;
+}
+
+void TextureFile::Close()
+{
+#ifdef _WIN32
+    if (mData) UnmapViewOfFile(mData);
+    if (mMappingHandle) CloseHandle(mMappingHandle);
+    if (mFileHandle) CloseHandle(mFileHandle);
+#else
+    if (mData) munmap(const_cast<unsigned char*>(mData), mSize);
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+    mWidth = 0;
+    mHeight = 0;
+    mFileHandle = nullptr;
+    mMappingHandle = nullptr;
+}
+
+const void* TextureFile::GetPixels() const
+{
+    return mData ? mData + sizeof(Header) : nullptr;
+}
+
+std::string TextureFile::GetBakedPath(const std::string& imagePath)
+{
+    return std::filesystem::path(imagePath).replace_extension(".stex").generic_string();
+}
+
+bool TextureFile::HasBakedCopy(const std::string& imagePath)
+{
+    std::error_code ec{};
+    auto bakedTime = std::filesystem::last_write_time(GetBakedPath(imagePath), ec);
+    if (ec) return false;
+
+    // Art edited after the last bake falls back to the png until it is baked again
+    auto imageTime = std::filesystem::last_write_time(imagePath, ec);
+    return ec || bakedTime >= imageTime;
+}
+
+bool TextureFile::Write(SDL_Surface* surface, const std::string& path)
+{
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba)
+    {
+        SDL_Log("Failed to convert surface for %s: %s", path.c_str(), SDL_GetError());
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        SDL_Log("Failed to open %s for writing", path.c_str());
+        SDL_FreeSurface(rgba);
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.width = static_cast<uint32_t>(rgba->w);
+    header.height = static_cast<uint32_t>(rgba->h);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    // Rows go out without the surface's pitch padding
+    const auto* pixels = static_cast<const char*>(rgba->pixels);
+    for (int y = 0; y < rgba->h; ++y)
+        file.write(pixels + static_cast<size_t>(y) * rgba->pitch, static_cast<std::streamsize>(rgba->w) * 4);
+
+    SDL_FreeSurface(rgba);
+    return file.good();
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+struct SDL_Surface;
+
+// Raw RGBA container written offline by the texture baker: a 16 byte header followed by the
+// pixels, rows top to bottom exactly as glTexImage2D wants them. Opening one maps the file
+// instead of reading it, so loading is a page-in plus the upload with no decode in between
+class TextureFile
+{
+public:
+    TextureFile();
+    ~TextureFile();
+
+    TextureFile(const TextureFile&) = delete;
+    TextureFile& operator=(const TextureFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    int GetWidth() const { return mWidth; }
+    int GetHeight() const { return mHeight; }
+    const void* GetPixels() const;
+
+    // Where the baked copy of an image lives, next to it with its own extension
+    static std::string GetBakedPath(const std::string& imagePath);
+
+    // True when a baked copy exists and is not older than the image it came from
+    static bool HasBakedCopy(const std::string& imagePath);
+
+    // Converts the surface to RGBA and writes it out
+    static bool Write(SDL_Surface* surface, const std::string& path);
+
+private:
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    static constexpr char MAGIC[4] = {'S', 'T', 'E', 'X'};
+    static constexpr uint32_t VERSION = 1;
+
+    const unsigned char* mData;
+    size_t mSize;
+    int mWidth;
+    int mHeight;
+
+    // Platform handles kept alive for as long as the view is mapped
+    void* mFileHandle;
+    void* mMappingHandle;
+};
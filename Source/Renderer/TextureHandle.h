@@ -0,0 +1,35 @@
+#pragma once
+#include <utility>
+#include "Texture.h"
+
+// Shared reference to a renderer texture. Whoever draws with a texture keeps one of these
+// instead of a raw pointer, so the renderer knows which textures it can evict
+class TextureHandle
+{
+public:
+    TextureHandle() : mTexture(nullptr) {}
+    explicit TextureHandle(Texture* texture) : mTexture(texture) { if (mTexture) mTexture->AddRef(); }
+    ~TextureHandle() { Reset(); }
+
+    TextureHandle(const TextureHandle& other) : TextureHandle(other.mTexture) {}
+    TextureHandle(TextureHandle&& other) noexcept : mTexture(other.mTexture) { other.mTexture = nullptr; }
+
+    TextureHandle& operator=(TextureHandle other) noexcept
+    {
+        std::swap(mTexture, other.mTexture);
+        return *this;
+    }
+
+    void Reset()
+    {
+        if (mTexture) mTexture->Release();
+        mTexture = nullptr;
+    }
+
+    Texture* Get() const { return mTexture; }
+    Texture* operator->() const { return mTexture; }
+    explicit operator bool() const { return mTexture != nullptr; }
+
+private:
+    Texture* mTexture;
+};
@@ -0,0 +1,156 @@
+#include "TextureStreamer.h"
+#include <GL/glew.h>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cstring>
+#include "Texture.h"
+#include "TextureFile.h"
+
+TextureStreamer::TextureStreamer()
+    : mIsStopping(false)
+    , mPendingCount(0)
+    , mPixelBuffer(0)
+{
+    glGenBuffers(1, &mPixelBuffer);
+    mWorker = std::thread(&TextureStreamer::WorkerLoop, this);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mCondition.notify_one();
+    mWorker.join();
+
+    glDeleteBuffers(1, &mPixelBuffer);
+}
+
+void TextureStreamer::Request(Texture* texture, const std::string& fileName)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(Job{texture, fileName});
+    }
+    mCondition.notify_one();
+    ++mPendingCount;
+}
+
+int TextureStreamer::Upload(float budgetMs)
+{
+    if (mPendingCount == 0) return 0;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+    int uploaded = 0;
+    while (true)
+    {
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDecoded.empty()) return uploaded;
+            image = std::move(mDecoded.front());
+            mDecoded.pop_front();
+        }
+        --mPendingCount;
+        ++uploaded;
+
+        // Failed decodes keep their placeholder, Decode already logged why
+        if (!image.pixels.empty())
+        {
+            // Orphan the staging storage and copy into it, the driver moves it to the texture on its own time
+            size_t size = image.pixels.size();
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mPixelBuffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            void* staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+            if (staging)
+            {
+                std::memcpy(staging, image.pixels.data(), size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                image.texture->CreateFromPixels(image.width, image.height, nullptr);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                image.texture->CreateFromPixels(image.width, image.height, image.pixels.data());
+            }
+        }
+
+        double elapsedMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / frequency;
+        if (elapsedMs >= budgetMs) return uploaded;
+    }
+}
+
+void TextureStreamer::WorkerLoop()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mIsStopping || !mJobs.empty(); });
+            if (mIsStopping) return;
+
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+        }
+
+        DecodedImage image;
+        image.texture = job.texture;
+        image.fileName = std::move(job.fileName);
+        if (!Decode(image.fileName, image))
+            image.pixels.clear();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDecoded.push_back(std::move(image));
+    }
+}
+
+bool TextureStreamer::Decode(const std::string& fileName, DecodedImage& outImage)
+{
+    if (TextureFile::HasBakedCopy(fileName))
+    {
+        TextureFile file;
+        if (file.Open(TextureFile::GetBakedPath(fileName)))
+        {
+            outImage.width = file.GetWidth();
+            outImage.height = file.GetHeight();
+
+            const auto* pixels = static_cast<const unsigned char*>(file.GetPixels());
+            outImage.pixels.assign(pixels, pixels + static_cast<size_t>(outImage.width) * outImage.height * 4);
+            return true;
+        }
+    }
+
+    SDL_Surface* surface = IMG_Load(fileName.c_str());
+    if (!surface)
+    {
+        SDL_Log("Failed to load texture file %s", fileName.c_str());
+        return false;
+    }
+
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (!rgba)
+    {
+        SDL_Log("Failed to convert texture file %s: %s", fileName.c_str(), SDL_GetError());
+        return false;
+    }
+
+    outImage.width = rgba->w;
+    outImage.height = rgba->h;
+
+    // Drop the surface's row padding so the upload can use the default unpack state
+    size_t rowSize = static_cast<size_t>(rgba->w) * 4;
+    outImage.pixels.resize(rowSize * rgba->h);
+    const auto* pixels = static_cast<const unsigned char*>(rgba->pixels);
+    for (int y = 0; y < rgba->h; ++y)
+        std::memcpy(outImage.pixels.data() + y * rowSize, pixels + static_cast<size_t>(y) * rgba->pitch, rowSize);
+
+    SDL_FreeSurface(rgba);
+    return true;
+}
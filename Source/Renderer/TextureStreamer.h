@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Decodes images on a worker thread and uploads them from the main thread a few per frame.
+// Requested textures show their placeholder until their pixels land, so no frame ever waits
+// on a PNG decode
+class TextureStreamer
+{
+public:
+    TextureStreamer();
+    ~TextureStreamer();
+
+    // The texture must already hold its placeholder and outlive the request
+    void Request(class Texture* texture, const std::string& fileName);
+
+    // Uploads decoded images until the budget is spent and returns how many went up.
+    // At least one goes up per call, so an image bigger than the budget still lands
+    int Upload(float budgetMs);
+
+    // Requested images not uploaded yet
+    int GetPendingCount() const { return mPendingCount; }
+
+private:
+    struct Job
+    {
+        class Texture* texture;
+        std::string fileName;
+    };
+
+    struct DecodedImage
+    {
+        class Texture* texture;
+        std::string fileName;
+        int width;
+        int height;
+        std::vector<unsigned char> pixels;
+    };
+
+    void WorkerLoop();
+
+    // Baked copy first, PNG decode otherwise. Pixels come out as tightly packed RGBA
+    static bool Decode(const std::string& fileName, DecodedImage& outImage);
+
+    std::thread mWorker;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mIsStopping;
+
+    std::deque<Job> mJobs;
+    std::deque<DecodedImage> mDecoded;
+    int mPendingCount;
+
+    // Staging buffer the driver copies from, the main thread only writes into it
+    unsigned int mPixelBuffer;
+};
@@ -0,0 +1,155 @@
+#include "TileMapMesh.h"
+#include "Renderer.h"
+#include "VertexArray.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+#include "../Json.h"
+#include "../Components/Drawing/AnimatorComponent.h"
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+TileMapMesh::TileMapMesh(float tileSize, int chunkSize)
+    : mTileSize(tileSize)
+    , mChunkSize(chunkSize)
+    , mChunksX(0)
+    , mChunksY(0)
+    , mMeshCount(0)
+    , mTileCount(0)
+{
+}
+
+TileMapMesh::~TileMapMesh()
+{
+    Clear();
+}
+
+bool TileMapMesh::Build(Renderer *renderer, const std::string &animationPath, int **levelData, int width, int height)
+{
+    Clear();
+
+    std::ifstream animFile(animationPath);
+    if (!animFile.is_open())
+    {
+        SDL_Log("Failed to open tile animation file: %s", animationPath.c_str());
+        return false;
+    }
+
+    nlohmann::json animData = nlohmann::json::parse(animFile);
+    if (animData.is_null() || !animData.contains("image") || !animData.contains("spriteSheetData"))
+    {
+        SDL_Log("Failed to parse tile animation file: %s", animationPath.c_str());
+        return false;
+    }
+
+    std::vector<Sprite> sprites;
+    if (!AnimatorComponent::LoadSpriteSheetData(animData["spriteSheetData"].get<std::string>(), sprites))
+        return false;
+
+    Vector4 region;
+    mTexture = TextureHandle(renderer->GetTextureRegion(animData["image"].get<std::string>(), region));
+    if (!mTexture) return false;
+
+    for (auto &sprite : sprites)
+        sprite.uv = TextureAtlas::RemapRect(sprite.uv, region);
+
+    mChunksX = (width + mChunkSize - 1) / mChunkSize;
+    mChunksY = (height + mChunkSize - 1) / mChunkSize;
+    mChunks.assign(static_cast<size_t>(mChunksX) * mChunksY, nullptr);
+
+    std::vector<float> verts;
+    std::vector<unsigned int> indices;
+
+    for (int cy = 0; cy < mChunksY; ++cy)
+    {
+        for (int cx = 0; cx < mChunksX; ++cx)
+        {
+            verts.clear();
+            indices.clear();
+
+            int maxX = std::min((cx + 1) * mChunkSize, width);
+            int maxY = std::min((cy + 1) * mChunkSize, height);
+
+            for (int y = cy * mChunkSize; y < maxY; ++y)
+            {
+                for (int x = cx * mChunkSize; x < maxX; ++x)
+                {
+                    int tileID = levelData[y][x];
+                    if (!IsDrawnTileID(tileID) || tileID >= static_cast<int>(sprites.size())) continue;
+
+                    // World space corners, the camera offset is applied by the shader
+                    float x0 = x * mTileSize;
+                    float y0 = y * mTileSize;
+                    float x1 = x0 + mTileSize;
+                    float y1 = y0 + mTileSize;
+
+                    const Vector4 &uv = sprites[tileID].uv;
+                    float u0 = uv.x;
+                    float v0 = uv.y;
+                    float u1 = uv.x + uv.z;
+                    float v1 = uv.y + uv.w;
+
+                    auto first = static_cast<unsigned int>(verts.size() / 4);
+                    verts.insert(verts.end(), {
+                        x0, y0, u0, v0,
+                        x1, y0, u1, v0,
+                        x1, y1, u1, v1,
+                        x0, y1, u0, v1
+                    });
+                    indices.insert(indices.end(), {
+                        first, first + 1, first + 2,
+                        first + 2, first + 3, first
+                    });
+                    ++mTileCount;
+                }
+            }
+
+            if (indices.empty()) continue;
+
+            mChunks[cy * mChunksX + cx] = new VertexArray(verts.data(), static_cast<unsigned int>(verts.size() / 4),
+                                                          indices.data(), static_cast<unsigned int>(indices.size()));
+            ++mMeshCount;
+        }
+    }
+
+    return true;
+}
+
+void TileMapMesh::Clear()
+{
+    for (auto chunk : mChunks)
+        delete chunk;
+
+    mChunks.clear();
+    mChunksX = 0;
+    mChunksY = 0;
+    mMeshCount = 0;
+    mTileCount = 0;
+    mTexture.Reset();
+}
+
+void TileMapMesh::Draw(Renderer *renderer, const Vector2 &cameraPos, const Vector2 &viewSize)
+{
+    if (mMeshCount == 0) return;
+
+    float chunkWorldSize = mChunkSize * mTileSize;
+    int minX = std::max(static_cast<int>(std::floor(cameraPos.x / chunkWorldSize)), 0);
+    int minY = std::max(static_cast<int>(std::floor(cameraPos.y / chunkWorldSize)), 0);
+    int maxX = std::min(static_cast<int>(std::floor((cameraPos.x + viewSize.x) / chunkWorldSize)), mChunksX - 1);
+    int maxY = std::min(static_cast<int>(std::floor((cameraPos.y + viewSize.y) / chunkWorldSize)), mChunksY - 1);
+
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            auto chunk = mChunks[y * mChunksX + x];
+            if (chunk)
+                renderer->DrawMesh(chunk, mTexture.Get(), cameraPos);
+        }
+    }
+}
+
+bool TileMapMesh::IsDrawnTileID(int tileID)
+{
+    return (tileID >= 4 && tileID <= 10 && tileID != 9) || (tileID >= 16 && tileID <= 27);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../Math.h"
+#include "TextureHandle.h"
+
+// Static level tiles baked into one vertex array per chunk of the map. Tiles never move,
+// so the geometry is built once per level and each visible chunk is a single draw call.
+class TileMapMesh
+{
+public:
+    TileMapMesh(float tileSize, int chunkSize);
+    ~TileMapMesh();
+
+    // Reads the tile sheet from an animation file (tile ID N uses frame N) and bakes every drawn tile
+    bool Build(class Renderer *renderer, const std::string &animationPath, int **levelData, int width, int height);
+    void Clear();
+
+    // Only the chunks overlapping the view are touched, so the cost does not grow with the level
+    void Draw(class Renderer *renderer, const Vector2 &cameraPos, const Vector2 &viewSize);
+
+    // Floors and walls, the carpet (9) is drawn by the LevelPortal
+    static bool IsDrawnTileID(int tileID);
+
+    int GetChunkCount() const { return mMeshCount; }
+    int GetTileCount() const { return mTileCount; }
+
+private:
+    float mTileSize;
+    int mChunkSize;
+    int mChunksX;
+    int mChunksY;
+    int mMeshCount;
+    int mTileCount;
+
+    // One entry per chunk, row major; empty chunks stay null
+    std::vector<class VertexArray *> mChunks;
+    TextureHandle mTexture;
+};
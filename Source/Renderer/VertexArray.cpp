@@ -1,5 +1,6 @@
 #include "VertexArray.h"
 #include <GL/glew.h>
+#include "GLStateCache.h"
 
 VertexArray::VertexArray(const float* verts, unsigned int numVerts, const unsigned int* indices,
 						 unsigned int numIndices)
@@ -14,7 +15,7 @@ VertexArray::VertexArray(const float* verts, unsigned int numVerts, const unsign
 
 	// Create vertex array
 	glGenVertexArrays(1, &mVertexArray);
-	glBindVertexArray(mVertexArray);
+	GLStateCache::BindVertexArray(mVertexArray);
 
 	// Create vertex buffer
 	glGenBuffers(1, &mVertexBuffer);
@@ -33,7 +34,7 @@ VertexArray::VertexArray(const float* verts, unsigned int numVerts, const unsign
 	glEnableVertexAttribArray(1);
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, (GLsizei)VERTEX_SIZE, (void*)(2 * sizeof(float)));
 
-	glBindVertexArray(0);
+	GLStateCache::BindVertexArray(0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
@@ -42,11 +43,12 @@ VertexArray::~VertexArray()
 {
 	glDeleteBuffers(1, &mVertexBuffer);
 	glDeleteBuffers(1, &mIndexBuffer);
+	GLStateCache::ForgetVertexArray(mVertexArray);
 	glDeleteVertexArrays(1, &mVertexArray);
 }
 
 void VertexArray::SetActive() const
 {
-	glBindVertexArray(mVertexArray);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+	// The index buffer was bound while the vertex array was, so it comes along with it
+	GLStateCache::BindVertexArray(mVertexArray);
 }
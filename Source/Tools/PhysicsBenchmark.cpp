@@ -0,0 +1,106 @@
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <cstdlib>
+#include "../Components/Physics/Physics.h"
+#include "../Components/Physics/Collider.h"
+#include "../Random.h"
+
+// The narrowphase selection as it was before shape tags, kept here only as the baseline.
+// Circle-polygon never had a cast branch, it is routed to the same routine so both sides do equal work
+static bool CheckPairWithCasts(const Collider *a, Vector2 positionA, const Collider *b, Vector2 positionB)
+{
+    if (const AABBCollider *aabb = dynamic_cast<const AABBCollider *>(a))
+    {
+        if (const AABBCollider *other = dynamic_cast<const AABBCollider *>(b))
+            return Physics::CheckAABBAABB(aabb, other, &positionA, &positionB);
+        else if (const CircleCollider *circle = dynamic_cast<const CircleCollider *>(b))
+            return Physics::CheckAABBCircle(aabb, circle, &positionA, &positionB);
+        else if (const PolygonCollider *poly = dynamic_cast<const PolygonCollider *>(b))
+            return Physics::CheckPolygonAABB(poly, aabb, &positionB, &positionA);
+    }
+    else if (const CircleCollider *circle = dynamic_cast<const CircleCollider *>(a))
+    {
+        if (const CircleCollider *other = dynamic_cast<const CircleCollider *>(b))
+            return Physics::CheckCircleCircle(circle, other, &positionA, &positionB);
+        else if (const AABBCollider *aabb = dynamic_cast<const AABBCollider *>(b))
+            return Physics::CheckAABBCircle(aabb, circle, &positionB, &positionA);
+        else if (const PolygonCollider *poly = dynamic_cast<const PolygonCollider *>(b))
+            return Physics::CheckCirclePolygon(circle, poly, &positionA, &positionB);
+    }
+    else if (const PolygonCollider *poly = dynamic_cast<const PolygonCollider *>(a))
+    {
+        if (const PolygonCollider *other = dynamic_cast<const PolygonCollider *>(b))
+            return Physics::CheckPolygonPolygon(poly, other, &positionA, &positionB);
+        else if (const AABBCollider *aabb = dynamic_cast<const AABBCollider *>(b))
+            return Physics::CheckPolygonAABB(poly, aabb, &positionA, &positionB);
+        else if (const CircleCollider *circle = dynamic_cast<const CircleCollider *>(b))
+            return Physics::CheckCirclePolygon(circle, poly, &positionB, &positionA);
+    }
+
+    return false;
+}
+
+// Times narrowphase pair tests through Physics::CheckPair against the old dynamic_cast chain
+// and logs the throughput of both. Takes the number of pair tests as its only argument
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    if (iterations <= 0)
+    {
+        SDL_Log("Usage: physics_benchmark [iterations]");
+        return 1;
+    }
+
+    // Same pairs every run so results can be compared between builds
+    Random::Seed(1);
+
+    // Positions are always passed in, so the shapes don't need a component
+    AABBCollider aabb(48.0f, 32.0f);
+    CircleCollider circle(40.0f);
+    PolygonCollider cone(Physics::GetConeVertices(Vector2::Zero, Vector2(1.0f, 0.0f), Math::Pi / 3.0f, 120.0f));
+
+    const Collider *shapes[] = {&aabb, &circle, &cone};
+    constexpr int SHAPE_COUNT = 3;
+
+    // Spread the second shape around the first so roughly half of the tests hit
+    constexpr int OFFSET_COUNT = 64;
+    Vector2 offsets[OFFSET_COUNT];
+    for (auto &offset : offsets)
+        offset = Vector2(Random::GetFloatRange(-150.0f, 150.0f), Random::GetFloatRange(-150.0f, 150.0f));
+
+    // Only AABBs and circles exist on the hot path (bodies, walls, projectiles), so time them
+    // separately from the full set which is dominated by polygon SAT
+    for (int shapeCount : {2, SHAPE_COUNT})
+    {
+        int hitsTable = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < iterations; ++i)
+        {
+            const Collider *a = shapes[i % shapeCount];
+            const Collider *b = shapes[(i / shapeCount) % shapeCount];
+            if (Physics::CheckPair(a, Vector2::Zero, b, offsets[i % OFFSET_COUNT])) ++hitsTable;
+        }
+        Uint64 tableTicks = SDL_GetPerformanceCounter() - start;
+
+        int hitsCasts = 0;
+        start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < iterations; ++i)
+        {
+            const Collider *a = shapes[i % shapeCount];
+            const Collider *b = shapes[(i / shapeCount) % shapeCount];
+            if (CheckPairWithCasts(a, Vector2::Zero, b, offsets[i % OFFSET_COUNT])) ++hitsCasts;
+        }
+        Uint64 castTicks = SDL_GetPerformanceCounter() - start;
+
+        double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        double tableMs = tableTicks * 1000.0 / frequency;
+        double castMs = castTicks * 1000.0 / frequency;
+
+        SDL_Log("[BENCH] %d pair tests (%s): table %.2f ms (%.1f M/s), dynamic_cast chain %.2f ms (%.1f M/s), hits %d/%d",
+                iterations, shapeCount == SHAPE_COUNT ? "all shapes" : "AABB/circle",
+                tableMs, iterations / (tableMs * 1000.0), castMs, iterations / (castMs * 1000.0),
+                hitsTable, hitsCasts);
+    }
+
+    return 0;
+}
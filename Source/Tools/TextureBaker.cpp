@@ -0,0 +1,170 @@
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../Renderer/TextureFile.h"
+
+namespace
+{
+    // Each image is loaded this many times per path and the average is reported
+    constexpr int BENCH_RUNS = 5;
+
+    double ElapsedMs(Uint64 start)
+    {
+        return (SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    }
+
+    // Reads every byte once, standing in for the upload which has to touch all the pixels
+    unsigned int TouchPixels(const void *pixels, size_t size)
+    {
+        const auto *bytes = static_cast<const unsigned char *>(pixels);
+        unsigned int sum = 0;
+        for (size_t i = 0; i < size; ++i)
+            sum += bytes[i];
+        return sum;
+    }
+
+    // What Texture::Load does before its upload, with and without a baked copy.
+    // Returns the average milliseconds per load, or a negative value if it failed
+    double TimePngLoad(const std::string &imagePath, unsigned int &checksum)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int run = 0; run < BENCH_RUNS; ++run)
+        {
+            SDL_Surface *surface = IMG_Load(imagePath.c_str());
+            if (!surface) return -1.0;
+
+            checksum += TouchPixels(surface->pixels, static_cast<size_t>(surface->pitch) * surface->h);
+            SDL_FreeSurface(surface);
+        }
+        return ElapsedMs(start) / BENCH_RUNS;
+    }
+
+    double TimeBakedLoad(const std::string &imagePath, unsigned int &checksum)
+    {
+        std::string bakedPath = TextureFile::GetBakedPath(imagePath);
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int run = 0; run < BENCH_RUNS; ++run)
+        {
+            TextureFile file;
+            if (!file.Open(bakedPath)) return -1.0;
+
+            checksum += TouchPixels(file.GetPixels(), static_cast<size_t>(file.GetWidth()) * file.GetHeight() * 4);
+        }
+        return ElapsedMs(start) / BENCH_RUNS;
+    }
+
+    // Headless stand-in for the texture half of a scene switch: png decode against the mapped
+    // baked copy for every image under the folders. GL upload is left out, it is the same for both
+    void RunBenchmark(const std::vector<std::string> &folders)
+    {
+        double totalPng = 0.0;
+        double totalBaked = 0.0;
+        int count = 0;
+        unsigned int checksum = 0;
+
+        for (const auto &folder : folders)
+        {
+            std::error_code ec{};
+            for (const auto &entry : std::filesystem::recursive_directory_iterator{folder, ec})
+            {
+                if (!entry.is_regular_file() || entry.path().extension() != ".png")
+                    continue;
+
+                std::string imagePath = entry.path().generic_string();
+                if (!TextureFile::HasBakedCopy(imagePath))
+                    continue;
+
+                double pngMs = TimePngLoad(imagePath, checksum);
+                double bakedMs = TimeBakedLoad(imagePath, checksum);
+                if (pngMs < 0.0 || bakedMs < 0.0)
+                {
+                    SDL_Log("[BENCH] %s: failed to load", imagePath.c_str());
+                    continue;
+                }
+
+                SDL_Log("[BENCH] %s: png %.3f ms, baked %.3f ms", imagePath.c_str(), pngMs, bakedMs);
+                totalPng += pngMs;
+                totalBaked += bakedMs;
+                ++count;
+            }
+        }
+
+        SDL_Log("[BENCH] %d images: png %.2f ms total, baked %.2f ms total (checksum %u)",
+                count, totalPng, totalBaked, checksum);
+    }
+}
+
+// Offline step of the texture pipeline: writes a .stex next to every png under the given
+// folders (the whole Assets folder by default). Run it from the build folder like the game,
+// Texture::Load picks the baked copies up on its own.
+// With --bench it then times png decode against the baked copies of the same images
+int main(int argc, char **argv)
+{
+    int imgFlags = IMG_INIT_PNG;
+    if (!(IMG_Init(imgFlags) & imgFlags))
+    {
+        SDL_Log("Unable to initialize SDL_image: %s", IMG_GetError());
+        return 1;
+    }
+
+    bool runBenchmark = false;
+    std::vector<std::string> folders;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)
+            runBenchmark = true;
+        else
+            folders.emplace_back(argv[i]);
+    }
+    if (folders.empty())
+        folders.emplace_back("../Assets");
+
+    int baked = 0;
+    int skipped = 0;
+    int failed = 0;
+
+    for (const auto &folder : folders)
+    {
+        std::error_code ec{};
+        for (const auto &entry : std::filesystem::recursive_directory_iterator{folder, ec})
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != ".png")
+                continue;
+
+            std::string imagePath = entry.path().generic_string();
+            if (TextureFile::HasBakedCopy(imagePath))
+            {
+                ++skipped;
+                continue;
+            }
+
+            SDL_Surface *surface = IMG_Load(imagePath.c_str());
+            if (!surface)
+            {
+                SDL_Log("Failed to load %s: %s", imagePath.c_str(), IMG_GetError());
+                ++failed;
+                continue;
+            }
+
+            if (TextureFile::Write(surface, TextureFile::GetBakedPath(imagePath)))
+                ++baked;
+            else
+                ++failed;
+
+            SDL_FreeSurface(surface);
+        }
+    }
+
+    SDL_Log("[BUILD] Baked %d textures, %d already up to date, %d failed", baked, skipped, failed);
+
+    if (runBenchmark)
+        RunBenchmark(folders);
+
+    IMG_Quit();
+    return failed > 0 ? 1 : 0;
+}
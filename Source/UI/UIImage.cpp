@@ -9,15 +9,16 @@
 
 UIImage::UIImage(class Game* game, const Vector2 &offset, const float scale, const float angle, int drawOrder)
         :UIElement(game, offset, scale, angle, drawOrder)
-        ,mTexture(nullptr)
+        ,mTexRect(Vector4::UnitRect)
 {
 
 }
 
 UIImage::UIImage(class Game* game, const std::string &imagePath, const Vector2 &offset, const float scale, const float angle, int drawOrder)
         :UIElement(game, offset, scale, angle)
+        ,mTexRect(Vector4::UnitRect)
 {
-    mTexture = GetGame()->GetRenderer()->GetTexture(imagePath);
+    mTexture = TextureHandle(GetGame()->GetRenderer()->GetTextureRegion(imagePath, mTexRect));
 }
 
 UIImage::~UIImage()
@@ -30,9 +31,9 @@ void UIImage::Draw(class Shader* shader)
     if(!mTexture || !mIsVisible)
         return;
 
-    // Scale the quad by the width/height of texture
-    Matrix4 scaleMat = Matrix4::CreateScale(static_cast<float>(mTexture->GetWidth()) * mScale,
-                                            static_cast<float>(mTexture->GetHeight()) * mScale, 1.0f);
+    // Scale the quad by the width/height of the image's part of the texture
+    Matrix4 scaleMat = Matrix4::CreateScale(static_cast<float>(mTexture->GetWidth()) * mTexRect.z * mScale,
+                                            static_cast<float>(mTexture->GetHeight()) * mTexRect.w * mScale, 1.0f);
 
     Matrix4 rotMat = Matrix4::CreateRotationZ(mAngle);
 
@@ -47,14 +48,14 @@ void UIImage::Draw(class Shader* shader)
 
     // Set world transform
     Matrix4 world = scaleMat * rotMat * transMat;
-    shader->SetMatrixUniform("uWorldTransform", world);
+    shader->SetMatrixUniform(ShaderUniform::WorldTransform, world);
 
-    shader->SetVectorUniform("uColor", Color::White);
-    shader->SetVectorUniform("uTexRect", Vector4::UnitRect);
-    shader->SetVectorUniform("uCameraPos", Vector2::Zero);
+    shader->SetVectorUniform(ShaderUniform::Color, Color::White);
+    shader->SetVectorUniform(ShaderUniform::TexRect, mTexRect);
+    shader->SetVectorUniform(ShaderUniform::CameraPos, Vector2::Zero);
 
     // Set uTextureFactor
-    shader->SetFloatUniform("uTextureFactor", 1.0f);
+    shader->SetFloatUniform(ShaderUniform::TextureFactor, 1.0f);
 
     // Set current texture
     mTexture->SetActive();
@@ -3,6 +3,7 @@
 #include <string>
 #include <SDL_image.h>
 #include "UIElement.h"
+#include "../Renderer/TextureHandle.h"
 
 class UIImage : public UIElement
 {
@@ -15,5 +16,7 @@ public:
     void Draw(class Shader* shader) override;
 
 protected:
-    class Texture* mTexture;
+    TextureHandle mTexture;
+    // Where the image sits on the texture, the unit rect unless it was packed into the atlas
+    Vector4 mTexRect;
 };
@@ -25,11 +25,11 @@ void UIRect::Draw(class Shader* shader)
 
     // Set world transform
     Matrix4 world = scaleMat * rotMat * transMat;
-    shader->SetMatrixUniform("uWorldTransform", world);
+    shader->SetMatrixUniform(ShaderUniform::WorldTransform, world);
 
     // Set uTextureFactor and color
-    shader->SetFloatUniform("uTextureFactor", 0.0f);
-    shader->SetVectorUniform("uBaseColor", mColor);
+    shader->SetFloatUniform(ShaderUniform::TextureFactor, 0.0f);
+    shader->SetVectorUniform(ShaderUniform::BaseColor, mColor);
 
     // Draw quad
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
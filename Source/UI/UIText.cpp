@@ -2,12 +2,15 @@
 #include "../Renderer/Font.h"
 #include "../Renderer/Texture.h"
 #include "../Renderer/Shader.h"
+#include "../Renderer/Renderer.h"
 #include "../GameConstants.h"
 
 UIText::UIText(class Game* game, const std::string& text, class Font* font, const Vector2 &offset, float scale, float angle,
                int pointSize, const unsigned wrapLength, int drawOrder)
    :UIImage(game, offset, scale, angle, drawOrder)
    ,mFont(font)
+   ,mAtlas(font ? font->GetGlyphAtlas(pointSize) : nullptr)
+   ,mTextSize(Vector2::Zero)
    ,mPointSize(pointSize)
    ,mWrapLength(wrapLength)
    ,mTextColor(Color::White)
@@ -24,61 +27,78 @@ UIText::~UIText()
 
 void UIText::SetText(const std::string &text)
 {
-    // Clear out previous title texture if it exists
-    if (mTexture)
-    {
-        mTexture->Unload();
-        delete mTexture;
-        mTexture = nullptr;
-    }
+    // Laying out from the atlas is cheap, but labels updated every frame rarely change
+    if (text == mText && !mGlyphs.empty()) return;
 
-    // Create texture for title
     mText = text;
-    mTexture = mFont->RenderText(mText, mTextColor, mPointSize, mWrapLength);
+    if (mAtlas)
+        mTextSize = mAtlas->LayoutText(mText, mWrapLength, mGlyphs);
 }
 
 void UIText::SetTextColor(const Vector3 &color)
 {
-    // Clear out previous title texture if it exists
-    if (mTexture)
-    {
-        mTexture->Unload();
-        delete mTexture;
-        mTexture = nullptr;
-    }
-
+    // Color is a vertex attribute, nothing to rasterize again
     mTextColor = color;
-    mTexture = mFont->RenderText(mText, mTextColor, mPointSize, mWrapLength);
 }
 
 void UIText::Draw(class Shader* shader)
 {
-    if(!mTexture || !mIsVisible)
+    if(mGlyphs.empty() || !mIsVisible)
         return;
 
     // Draw Text Background
     if (mBackgroundColor.w > 0.0001f) // Skip if fully transparent
         {
-        Matrix4 scaleMat = Matrix4::CreateScale((static_cast<float>(mTexture->GetWidth()) + mMargin.x) * mScale,
-                                                (static_cast<float>(mTexture->GetHeight()) + mMargin.y) * mScale, 1.0f);
+        Matrix4 scaleMat = Matrix4::CreateScale((mTextSize.x + mMargin.x) * mScale,
+                                                (mTextSize.y + mMargin.y) * mScale, 1.0f);
 
         // Translate to position on screen
         Matrix4 transMat = Matrix4::CreateTranslation(Vector3(mOffset.x + GameConstants::WINDOW_WIDTH / 2, mOffset.y + GameConstants::WINDOW_HEIGHT / 2, 0.0f));
 
         // Set world transform
         Matrix4 world = scaleMat * transMat;
-        shader->SetMatrixUniform("uWorldTransform", world);
-        shader->SetVectorUniform("uTexRect", Vector4::UnitRect);
-        shader->SetVectorUniform("uCameraPos", Vector2::Zero);
+        shader->SetMatrixUniform(ShaderUniform::WorldTransform, world);
+        shader->SetVectorUniform(ShaderUniform::TexRect, Vector4::UnitRect);
+        shader->SetVectorUniform(ShaderUniform::CameraPos, Vector2::Zero);
 
         // Set uTextureFactor and color
-        shader->SetFloatUniform("uTextureFactor", 0.0f); // add alpha later
-        shader->SetVectorUniform("uColor", Vector3(mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z   ));
+        shader->SetFloatUniform(ShaderUniform::TextureFactor, 0.0f); // add alpha later
+        shader->SetVectorUniform(ShaderUniform::Color, Vector3(mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z   ));
 
         // Draw quad
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
     }
 
-    // Draw text
-    UIImage::Draw(shader);
+    // Draw text, the same transform UIImage used for the rasterized texture
+    Vector2 center(mOffset.x + GameConstants::WINDOW_WIDTH / 2, mOffset.y + GameConstants::WINDOW_HEIGHT / 2);
+    if (mAbsolutePos.x >= 0.0f && mAbsolutePos.y >= 0.0f)
+        center = mAbsolutePos;
+
+    float cosAngle = Math::Cos(mAngle);
+    float sinAngle = Math::Sin(mAngle);
+    Vector2 halfSize = mTextSize * 0.5f;
+
+    auto toScreen = [&](const Vector2 &local)
+    {
+        Vector2 p = (local - halfSize) * mScale;
+        return Vector2(p.x * cosAngle - p.y * sinAngle + center.x, p.x * sinAngle + p.y * cosAngle + center.y);
+    };
+
+    Renderer *renderer = mGame->GetRenderer();
+    for (const auto &glyph : mGlyphs)
+    {
+        Vector2 corners[4] = {
+            toScreen(glyph.min), toScreen(Vector2(glyph.max.x, glyph.min.y)),
+            toScreen(glyph.max), toScreen(Vector2(glyph.min.x, glyph.max.y))};
+
+        const Vector4 &uv = glyph.uv;
+        Vector2 uvs[4] = {
+            Vector2(uv.x, uv.y), Vector2(uv.x + uv.z, uv.y),
+            Vector2(uv.x + uv.z, uv.y + uv.w), Vector2(uv.x, uv.y + uv.w)};
+
+        renderer->AddTextQuad(corners, uvs, mTextColor, mAtlas->GetTexture());
+    }
+
+    // Flush right away so the label stays between the elements drawn before and after it
+    renderer->FlushText();
 }
\ No newline at end of file
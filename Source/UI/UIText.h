@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <SDL.h>
 #include "../Math.h"
+#include "../Renderer/GlyphAtlas.h"
 #include "UIImage.h"
 
 class UIText : public UIImage {
@@ -21,6 +23,11 @@ public:
 protected:
     std::string mText;
     class Font* mFont;
+    class GlyphAtlas* mAtlas;
+
+    // Glyphs laid out from the atlas, relative to the top-left of the text box
+    std::vector<GlyphQuad> mGlyphs;
+    Vector2 mTextSize;
 
     unsigned int mPointSize;
     unsigned int mWrapLength;